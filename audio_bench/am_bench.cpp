@@ -0,0 +1,169 @@
+// Runs the firmware's Modulator unmodified over test tones, demodulates its envelope the way the air does and
+// measures the second harmonic each mode leaves, checks carrier tracking leaves the loudness alone and does not
+// clip a sudden onset, and times it. Build and run from this folder:
+//   g++ -std=gnu++17 -O2 -I. -I../fw/hearmeout/Core/Inc am_bench.cpp -o am_bench && ./am_bench
+// The timing is host ns per sample, the board prints M4 cycles per sample in its am stats line.
+
+#include "main.h"
+#include "modulator.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+DWT_Type bench_dwt;
+
+static constexpr double FS = 40000;
+static constexpr uint32_t BUFFER_SAMPLES = 512; // the size the firmware hands to process()
+static constexpr uint32_t SETTLE_SAMPLES = 20000; // carrier tracking and the integrators settle first
+static constexpr uint32_t MEASURE_SAMPLES = 8000; // a whole number of periods of every tone
+static constexpr int TIMING_RUNS = 50;
+
+// the pre-distorted modes are there to get rid of the second harmonic, plain AM is expected to be full of it
+static constexpr double MAX_H2_DB = -30;
+// the carrier tracking is only there to save power, what comes out of the air has to stay as loud
+static constexpr double MAX_TRACKING_DB = 0.5;
+static constexpr double LEVEL_TONE = 1000;
+static constexpr double LEVEL_AMPS[] = {0.05, 0.5};
+static constexpr double ONSET_AMP = 0.9;
+
+static char const* const MODE_NAMES[Modulator::NUM_MODES] = {"linear", "sqrt", "equalized"};
+
+static std::vector<uint16_t> tone(double f, double amp, uint32_t n){
+	std::vector<uint16_t> v(n);
+	for(uint32_t i = 0; i < n; ++i){
+		v[i] = static_cast<uint16_t>(static_cast<int16_t>(std::lround(amp * 32767 * std::sin(2 * M_PI * f * i / FS))));
+	}
+	return v;
+}
+
+static void process(Modulator& mod, std::vector<uint16_t>& buf){
+	for(size_t i = 0; i < buf.size(); i += BUFFER_SAMPLES){
+		mod.process(&buf[i], std::min<size_t>(BUFFER_SAMPLES, buf.size() - i));
+	}
+}
+
+// magnitude of frequency f in v
+static double dft(std::vector<double> const& v, double f){
+	double re = 0, im = 0;
+	for(size_t i = 0; i < v.size(); ++i){
+		re += v[i] * std::cos(2 * M_PI * f * i / FS);
+		im += v[i] * std::sin(2 * M_PI * f * i / FS);
+	}
+	return std::sqrt(re * re + im * im);
+}
+
+// what comes out of the air for a tone at f once the modulator has settled. the air demodulates the carrier
+// into the second derivative of the envelope squared
+static std::vector<double> air(Modulator::MODE m, bool tracking, double f, double amp){
+	Modulator mod;
+	mod.init();
+	mod.set_mode(m);
+	mod.set_tracking(tracking);
+	std::vector<uint16_t> buf = tone(f, amp, SETTLE_SAMPLES + MEASURE_SAMPLES);
+	process(mod, buf);
+
+	std::vector<double> power(MEASURE_SAMPLES);
+	for(uint32_t i = 0; i < MEASURE_SAMPLES; ++i){
+		double env = (static_cast<int16_t>(buf[SETTLE_SAMPLES + i]) + 32768) / 65536.0;
+		power[i] = env * env;
+	}
+	std::vector<double> demod(MEASURE_SAMPLES - 2);
+	for(uint32_t i = 0; i + 2 < MEASURE_SAMPLES; ++i){
+		demod[i] = power[i + 2] - 2 * power[i + 1] + power[i];
+	}
+	demod.resize(demod.size() - demod.size() % static_cast<size_t>(FS / f)); // whole periods only
+	return demod;
+}
+
+// second harmonic over fundamental in dB
+static double h2_db(Modulator::MODE m, double f, double amp){
+	std::vector<double> demod = air(m, true, f, amp);
+	return 20 * std::log10(dft(demod, 2 * f) / dft(demod, f));
+}
+
+// how much louder the tone comes out with the carrier tracking than with it fixed, in dB
+static double tracking_db(Modulator::MODE m, double amp){
+	return 20 * std::log10(dft(air(m, true, LEVEL_TONE, amp), LEVEL_TONE) / dft(air(m, false, LEVEL_TONE, amp), LEVEL_TONE));
+}
+
+// samples where the carrier was below the signal, a loud tone out of a second of silence so the carrier starts
+// from its floor. they come out as the carrier off
+static uint32_t onset_clips(Modulator::MODE m){
+	Modulator mod;
+	mod.init();
+	mod.set_mode(m);
+	std::vector<uint16_t> buf(static_cast<size_t>(FS), 0);
+	std::vector<uint16_t> burst = tone(LEVEL_TONE, ONSET_AMP, MEASURE_SAMPLES);
+	buf.insert(buf.end(), burst.begin(), burst.end());
+	process(mod, buf);
+	uint32_t clips = 0;
+	for(size_t i = static_cast<size_t>(FS); i < buf.size(); ++i){
+		clips += buf[i] == static_cast<uint16_t>(INT16_MIN);
+	}
+	return clips;
+}
+
+static double ns_per_sample(Modulator::MODE m){
+	Modulator mod;
+	mod.init();
+	mod.set_mode(m);
+	std::vector<uint16_t> in = tone(1000, 0.5, SETTLE_SAMPLES);
+	std::vector<uint16_t> buf(in.size());
+	double best_ns = 1e12;
+	for(int r = 0; r < TIMING_RUNS; ++r){
+		std::copy(in.begin(), in.end(), buf.begin());
+		auto start = std::chrono::steady_clock::now();
+		process(mod, buf);
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		best_ns = std::min(best_ns, ns / buf.size());
+	}
+	return best_ns;
+}
+
+int main(){
+	static constexpr double TONES[] = {200, 1000, 5000};
+	static constexpr double AMP = 0.5;
+
+	// set_mode() prints each switch, the tables come after
+	char rows[Modulator::NUM_MODES][128];
+	char tracking_rows[Modulator::NUM_MODES][128];
+	bool ok = true;
+	for(uint8_t i = 0; i < Modulator::NUM_MODES; ++i){
+		Modulator::MODE m = static_cast<Modulator::MODE>(i);
+		int len = snprintf(rows[i], sizeof(rows[i]), "%-10s", MODE_NAMES[i]);
+		for(double f : TONES){
+			double h2 = h2_db(m, f, AMP);
+			len += snprintf(rows[i] + len, sizeof(rows[i]) - len, " %9.1f", h2);
+			if(m != Modulator::LINEAR && h2 > MAX_H2_DB){
+				ok = false;
+			}
+		}
+		snprintf(rows[i] + len, sizeof(rows[i]) - len, " %10.2f", ns_per_sample(m));
+
+		len = snprintf(tracking_rows[i], sizeof(tracking_rows[i]), "%-10s", MODE_NAMES[i]);
+		for(double amp : LEVEL_AMPS){
+			double db = tracking_db(m, amp);
+			len += snprintf(tracking_rows[i] + len, sizeof(tracking_rows[i]) - len, " %9.2f", db);
+			if(std::fabs(db) > MAX_TRACKING_DB){
+				ok = false;
+			}
+		}
+		uint32_t clips = onset_clips(m);
+		snprintf(tracking_rows[i] + len, sizeof(tracking_rows[i]) - len, " %12u", clips);
+		if(clips){
+			ok = false;
+		}
+	}
+
+	printf("%-10s %9s %9s %9s %10s\n", "mode", "h2_200Hz", "h2_1kHz", "h2_5kHz", "ns/sample");
+	for(uint8_t i = 0; i < Modulator::NUM_MODES; ++i){
+		printf("%s\n", rows[i]);
+	}
+	printf("\n%-10s %9s %9s %12s\n", "tracking", "db_5%", "db_50%", "onset_clips");
+	for(uint8_t i = 0; i < Modulator::NUM_MODES; ++i){
+		printf("%s\n", tracking_rows[i]);
+	}
+	printf("%s\n", ok ? "PASS" : "FAIL");
+	return ok ? 0 : 1;
+}
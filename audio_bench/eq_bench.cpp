@@ -0,0 +1,166 @@
+// Runs the firmware's Equalizer unmodified over fixed test vectors, checks every preset against a double
+// precision reference of the same coefficients and against the golden output checked in below, and times it.
+// Build and run from this folder:
+//   g++ -std=gnu++17 -O2 -I. -I../fw/hearmeout/Core/Inc eq_bench.cpp -o eq_bench && ./eq_bench
+// The timing is host ns per sample, the board prints M4 cycles per sample in its eq stats line.
+// After an intended change to the filter arithmetic, ./eq_bench golden prints the new GOLDEN table.
+
+#include "main.h"
+#include "equalizer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+DWT_Type bench_dwt;
+
+static constexpr double FS = 40000;
+static constexpr uint32_t BUFFER_SAMPLES = 512; // the size the firmware hands to process()
+static constexpr int MAX_ERR_LSB = 1; // the fixed point output truncates, the reference rounds
+static constexpr int TIMING_RUNS = 50;
+
+// FNV-1a of every output sample, in PRESET order
+static constexpr uint32_t GOLDEN[Equalizer::NUM_PRESETS] = {
+	0x31e03372, 0xa584b614, 0xa0c5918d, 0xe4dab871
+};
+
+// impulse, full scale steps both ways, a log sweep, full scale tones and white noise, 1.3s in all
+static std::vector<int16_t> test_vectors(){
+	std::vector<int16_t> v;
+	v.push_back(INT16_MAX);
+	v.resize(2000, 0);
+	v.resize(v.size() + 4000, INT16_MAX);
+	v.resize(v.size() + 4000, INT16_MIN);
+	v.resize(v.size() + 2000, 0);
+
+	// 20Hz to 18kHz at -1dBFS over half a second
+	double const amp = 32767 * std::pow(10, -1 / 20.0);
+	double const sweep_n = FS / 2;
+	double const k = std::log(18000 / 20.0);
+	for(int i = 0; i < sweep_n; ++i){
+		double t = i / FS;
+		double phase = 2 * M_PI * 20 * (sweep_n / FS) / k * (std::exp(k * t / (sweep_n / FS)) - 1);
+		v.push_back(static_cast<int16_t>(std::lround(amp * std::sin(phase))));
+	}
+
+	for(double f : {100.0, 1000.0, 6000.0}){
+		for(int i = 0; i < 4000; ++i){
+			v.push_back(static_cast<int16_t>(std::lround(32767 * std::sin(2 * M_PI * f * i / FS))));
+		}
+	}
+
+	uint32_t lcg = 12345;
+	for(int i = 0; i < 8000; ++i){
+		lcg = lcg * 1664525 + 1013904223;
+		v.push_back(static_cast<int16_t>(lcg >> 16));
+	}
+	return v;
+}
+
+// the same cascade in doubles, rounded to 16 bits at the end
+static std::vector<int16_t> reference(Equalizer::PRESET p, std::vector<int16_t> const& in){
+	uint8_t n = Equalizer::get_num_stages(p);
+	double const scale = (1 << Equalizer::POST_SHIFT) / 2147483648.0;
+	std::vector<int16_t> out(in.size());
+	std::vector<double> st(4 * n, 0.0);
+	for(size_t i = 0; i < in.size(); ++i){
+		double x = in[i];
+		for(uint8_t s = 0; s < n; ++s){
+			BiquadCoeffs const& c = Equalizer::get_stage(p, s);
+			double* h = &st[4 * s];
+			double y = (c.b0 * x + c.b1 * h[0] + c.b2 * h[1] + c.a1 * h[2] + c.a2 * h[3]) * scale;
+			h[1] = h[0];
+			h[0] = x;
+			h[3] = h[2];
+			h[2] = y;
+			x = y;
+		}
+		out[i] = static_cast<int16_t>(std::lround(std::fmin(std::fmax(x, INT16_MIN), INT16_MAX)));
+	}
+	return out;
+}
+
+// the firmware filter, fed in buffers the way the audio task does
+static std::vector<int16_t> run(Equalizer& eq, Equalizer::PRESET p, std::vector<int16_t> const& in){
+	eq.set_preset(p);
+	std::vector<uint16_t> buf(in.begin(), in.end());
+	for(size_t i = 0; i < buf.size(); i += BUFFER_SAMPLES){
+		eq.process(&buf[i], std::min<size_t>(BUFFER_SAMPLES, buf.size() - i));
+	}
+	return std::vector<int16_t>(buf.begin(), buf.end());
+}
+
+static uint32_t fnv1a(std::vector<int16_t> const& v){
+	uint32_t h = 2166136261u;
+	for(int16_t s : v){
+		for(int b = 0; b < 2; ++b){
+			h ^= (static_cast<uint16_t>(s) >> (8 * b)) & 0xFF;
+			h *= 16777619u;
+		}
+	}
+	return h;
+}
+
+int main(int argc, char** argv){
+	bool print_golden = argc > 1 && strcmp(argv[1], "golden") == 0;
+	std::vector<int16_t> in = test_vectors();
+	Equalizer eq;
+	eq.init();
+
+	if(print_golden){
+		uint32_t hash[Equalizer::NUM_PRESETS];
+		for(uint8_t p = 0; p < Equalizer::NUM_PRESETS; ++p){
+			hash[p] = fnv1a(run(eq, static_cast<Equalizer::PRESET>(p), in));
+		}
+		printf("static constexpr uint32_t GOLDEN[Equalizer::NUM_PRESETS] = {\n\t");
+		for(uint8_t p = 0; p < Equalizer::NUM_PRESETS; ++p){
+			printf("0x%08x%s", hash[p], p + 1 < Equalizer::NUM_PRESETS ? ", " : "\n");
+		}
+		printf("};\n");
+		return 0;
+	}
+
+	// set_preset() prints each switch, the table comes after
+	char rows[Equalizer::NUM_PRESETS][96];
+	bool ok = true;
+	for(uint8_t i = 0; i < Equalizer::NUM_PRESETS; ++i){
+		Equalizer::PRESET p = static_cast<Equalizer::PRESET>(i);
+		std::vector<int16_t> out = run(eq, p, in);
+		std::vector<int16_t> ref = reference(p, in);
+
+		int max_err = 0;
+		double sum_sq = 0;
+		for(size_t n = 0; n < out.size(); ++n){
+			int e = std::abs(out[n] - ref[n]);
+			max_err = std::max(max_err, e);
+			sum_sq += static_cast<double>(e) * e;
+		}
+		bool golden = fnv1a(out) == GOLDEN[i];
+
+		// best of several runs, the first ones warm the caches
+		double best_ns = 1e12;
+		std::vector<uint16_t> buf(in.size());
+		for(int r = 0; r < TIMING_RUNS; ++r){
+			std::copy(in.begin(), in.end(), buf.begin());
+			eq.reset();
+			auto start = std::chrono::steady_clock::now();
+			for(size_t n = 0; n < buf.size(); n += BUFFER_SAMPLES){
+				eq.process(&buf[n], std::min<size_t>(BUFFER_SAMPLES, buf.size() - n));
+			}
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			best_ns = std::min(best_ns, ns / buf.size());
+		}
+
+		snprintf(rows[i], sizeof(rows[i]), "%-12s %6u %8d %8.3f %8s %10.2f", Equalizer::get_name(p),
+				Equalizer::get_num_stages(p), max_err, std::sqrt(sum_sq / out.size()), golden ? "ok" : "CHANGED", best_ns);
+		ok = ok && golden && max_err <= MAX_ERR_LSB;
+	}
+
+	printf("%-12s %6s %8s %8s %8s %10s\n", "preset", "stages", "max_lsb", "rms_lsb", "golden", "ns/sample");
+	for(uint8_t i = 0; i < Equalizer::NUM_PRESETS; ++i){
+		printf("%s\n", rows[i]);
+	}
+	printf("%s\n", ok ? "PASS" : "FAIL");
+	return ok ? 0 : 1;
+}
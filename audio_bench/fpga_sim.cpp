@@ -0,0 +1,385 @@
+// Runs the firmware's FpgaAudioOut and Touch unmodified on a simulated SPI2 against a clock by clock model of
+// the FIFO side of verilog/i2c_led/src/audio_out.sv, to check the DRQ / A_CS handshake and the bus sharing
+// with the touch controller without the hardware. Build and run from this folder:
+//   g++ -std=gnu++17 -O2 -I. -I../fw/hearmeout/Core/Inc fpga_sim.cpp -o fpga_sim && ./fpga_sim
+// The model follows the RTL register for register, a change to the SPI slave or the FIFO there goes here too.
+// The carrier itself is covered by the RTL bench in verilog/i2c_led/tb.
+
+#include "main.h"
+#include "audio_out.hpp"
+#include "touch.hpp"
+
+#include <vector>
+
+DWT_Type bench_dwt;
+GPIO_TypeDef bench_gpioa, bench_gpiod, bench_gpiof;
+EXTI_TypeDef bench_exti;
+
+// all times in ps
+static constexpr uint64_t US = 1000000;
+static constexpr uint64_t MS = 1000 * US;
+static constexpr uint64_t FPGA_CLK = 40000; // 25 MHz
+static constexpr uint64_t SPI_BIT = 533333; // SPI2 is 120 MHz / 64
+static constexpr uint64_t TASK_RUN = 20 * US; // any task run, on top of the SD read
+static constexpr uint64_t SD_READ = 3 * MS; // f_read and the filters for one buffer, the main loop waits on it
+static constexpr uint64_t AUDIO_PERIOD = 2 * MS; // task periods from hearmeout.cpp
+static constexpr uint64_t TOUCH_PERIOD = 10 * MS;
+
+// the pen is down over most of the song, which is paused once
+static constexpr uint64_t PRESS_AT = 300 * MS;
+static constexpr uint64_t RELEASE_AT = 1500 * MS;
+static constexpr uint64_t PAUSE_AT = 1800 * MS;
+static constexpr uint64_t PLAY_AT = 1900 * MS;
+static constexpr uint64_t END_AT = 3200 * MS;
+static constexpr uint64_t WARMUP = 50 * MS; // the FIFO fill is only tracked once it has come up
+static constexpr uint32_t SONG_SAMPLES = 100 * BUFFER_SIZE; // 2.56s
+// a burst that finds a chunk on the bus goes when it is done, and the one after it a touch period later
+static constexpr uint32_t MIN_TOUCH_BURSTS = (RELEASE_AT - PRESS_AT) / TOUCH_PERIOD * 3 / 4;
+
+// audio_out.sv with a 1024 sample FIFO at 25 MHz, one call per clock. the registers take their new values
+// only once everything has been worked out from the old ones, like the nonblocking assignments
+struct Fpga {
+	static constexpr uint32_t SAMPLE_DIV = 625;
+	static constexpr uint32_t DEPTH = 1024;
+	static constexpr uint32_t PTR_MASK = 2 * DEPTH - 1;
+
+	uint8_t sck_sync = 0;
+	uint8_t mosi_sync = 0;
+	uint8_t cs_sync = 3;
+	uint8_t spi_bit = 0;
+	uint8_t spi_shift = 0;
+	uint8_t spi_low = 0;
+	bool wr_en = false;
+	uint16_t wr_data = 0;
+	uint16_t mem[DEPTH] = {};
+	uint32_t wr_ptr = 0;
+	uint32_t rd_ptr = 0;
+	uint16_t rd_data = 0;
+	bool empty_q = true;
+	uint32_t phase = 0;
+	bool playing = false;
+	uint32_t underruns = 0;
+
+	uint32_t dropped = 0; // words that arrived while full
+	std::vector<uint16_t> played;
+
+	uint32_t fill() const {
+		return (wr_ptr - rd_ptr) & PTR_MASK;
+	}
+
+	bool drq() const {
+		return fill() <= DEPTH / 2;
+	}
+
+	void clock(bool sck_i, bool mosi_i, bool cs_n_i){
+		bool tick = phase == SAMPLE_DIV - 1;
+		bool pop = tick && !empty_q;
+		uint32_t f = fill();
+
+		// FIFO, the read register picks up the memory before this clock's write
+		uint16_t next_rd_data = mem[rd_ptr & (DEPTH - 1)];
+		if(wr_en){
+			if(f != DEPTH){
+				mem[wr_ptr & (DEPTH - 1)] = wr_data;
+				wr_ptr = (wr_ptr + 1) & PTR_MASK;
+			}else{
+				++dropped;
+			}
+		}
+		if(pop){
+			played.push_back(rd_data);
+			rd_ptr = (rd_ptr + 1) & PTR_MASK;
+		}
+
+		// sample clock
+		if(tick){
+			if(empty_q){
+				if(playing && underruns != 0xFF){
+					++underruns;
+				}
+				playing = false;
+			}else{
+				playing = true;
+			}
+		}
+		phase = tick ? 0 : phase + 1;
+		empty_q = f == 0;
+		rd_data = next_rd_data;
+
+		// SPI slave
+		wr_en = false;
+		if(cs_sync >> 1 & 1){
+			spi_bit = 0;
+		}else if((sck_sync >> 1 & 3) == 1){
+			uint8_t byte = static_cast<uint8_t>(spi_shift << 1 | (mosi_sync >> 1 & 1));
+			if(spi_bit == 7){
+				spi_low = byte;
+			}else if(spi_bit == 15){
+				wr_data = static_cast<uint16_t>(byte << 8 | spi_low);
+				wr_en = true;
+			}
+			spi_shift = byte & 0x7F;
+			spi_bit = (spi_bit + 1) & 0xF;
+		}
+
+		sck_sync = (sck_sync << 1 | sck_i) & 7;
+		mosi_sync = (mosi_sync << 1 | mosi_i) & 3;
+		cs_sync = (cs_sync << 1 | cs_n_i) & 3;
+	}
+};
+
+static SPI_HandleTypeDef hspi2;
+static FpgaAudioOut audio_out;
+static Touch touch;
+static Fpga fpga;
+
+static uint64_t sim_t;
+static bool pen_down;
+
+// the DMA transfer SPI2 is clocking out, mode 0 with no gaps between bytes
+static bool spi_active;
+static bool spi_touch; // TransmitReceive, the touch burst
+static uint64_t spi_start;
+static uint8_t const* spi_tx;
+static uint32_t spi_bytes;
+
+static uint32_t chunks;
+static uint32_t touch_bursts;
+static uint64_t last_touch_burst;
+static uint64_t max_touch_gap; // between bursts while the pen is down
+static uint32_t cs_errors;
+
+static bool a_cs(){
+	return bench_gpiod.ODR & A_CS_Pin;
+}
+
+static bool t_cs(){
+	return bench_gpiod.ODR & T_CS_Pin;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+	if(PinState == GPIO_PIN_SET){
+		GPIOx->ODR |= GPIO_Pin;
+	}else{
+		GPIOx->ODR &= ~static_cast<uint32_t>(GPIO_Pin);
+	}
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin){
+	if(GPIOx == GPIOD && GPIO_Pin == A_DRQ_Pin){
+		return fpga.drq() ? GPIO_PIN_SET : GPIO_PIN_RESET;
+	}
+	if(GPIOx == GPIOD && GPIO_Pin == GPIO_PIN_7){
+		return pen_down ? GPIO_PIN_RESET : GPIO_PIN_SET; // PENIRQ
+	}
+	return (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+static HAL_StatusTypeDef spi_start_dma(SPI_HandleTypeDef* hspi, uint8_t const* tx, uint16_t size, bool touch_burst){
+	if(hspi->State != HAL_SPI_STATE_READY){
+		return HAL_BUSY;
+	}
+	// exactly the device the transfer is meant for has to be selected
+	if(a_cs() == !touch_burst || t_cs() == touch_burst){
+		++cs_errors;
+	}
+	hspi->State = touch_burst ? HAL_SPI_STATE_BUSY_TX_RX : HAL_SPI_STATE_BUSY_TX;
+	spi_active = true;
+	spi_touch = touch_burst;
+	spi_start = sim_t;
+	spi_tx = tx;
+	spi_bytes = size;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size){
+	return spi_start_dma(hspi, pData, Size, false);
+}
+
+// the XPT2046 answers every frame with 1024, a press, while the pen is down and 0 once it is up
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size){
+	HAL_StatusTypeDef status = spi_start_dma(hspi, pTxData, Size, true);
+	if(status == HAL_OK){
+		for(uint16_t i = 0; i < Size; ++i){
+			pRxData[i] = (pen_down && i % 3 == 1) ? 0x40 : 0;
+		}
+	}
+	return status;
+}
+
+static uint16_t song_sample(uint32_t k){
+	return static_cast<uint16_t>(k * 40503u + 12345u);
+}
+
+static uint32_t produced;
+static bool silence_queued;
+
+// sd.hpp fill_from_wav(), the end of the song is padded with silence
+static void fill(uint16_t* buf){
+	for(uint32_t i = 0; i < BUFFER_SIZE; ++i){
+		if(produced < SONG_SAMPLES){
+			buf[i] = song_sample(produced++);
+		}else{
+			buf[i] = FpgaAudioOut::SILENCE;
+			silence_queued = true;
+		}
+	}
+}
+
+// main loop, audio and touch tasks as in hearmeout.cpp, a task runs once the previous one has finished
+static uint64_t busy_until;
+static bool audio_ready;
+static bool touch_ready;
+static bool service_pending; // the audio task's service() after its SD read
+
+static void audio_task(){
+	uint64_t run = TASK_RUN;
+	if(audio_out.refill_pending()){
+		if(silence_queued){
+			// the last of the song has been sent, the FPGA plays out its FIFO
+			audio_out.stop();
+		}else{
+			audio_out.refilled();
+			fill(audio_out.get_producer());
+			run += SD_READ;
+		}
+	}
+	service_pending = true;
+	busy_until = sim_t + run;
+}
+
+static void touch_task(){
+	TouchEvent event;
+	touch.service(static_cast<uint32_t>(sim_t / MS), &event);
+	busy_until = sim_t + TASK_RUN;
+}
+
+static void step(){
+	// SPI2 pins, MOSI changes with the falling edge and SCK rises half a bit later
+	bool sck = false;
+	bool mosi = false;
+	if(spi_active){
+		uint64_t elapsed = sim_t - spi_start;
+		uint64_t bit = elapsed / SPI_BIT;
+		if(bit < spi_bytes * 8){
+			sck = elapsed % SPI_BIT >= SPI_BIT / 2;
+			mosi = spi_tx[bit / 8] >> (7 - bit % 8) & 1;
+		}
+	}
+	if(!a_cs() && !t_cs()){
+		++cs_errors;
+	}
+
+	bool drq = fpga.drq();
+	fpga.clock(sck, mosi, a_cs());
+	if(!drq && fpga.drq()){
+		audio_ready = true; // EXTI on the DRQ rising edge
+	}
+
+	// DMA complete callbacks
+	if(spi_active && sim_t - spi_start >= spi_bytes * 8 * SPI_BIT){
+		spi_active = false;
+		hspi2.State = HAL_SPI_STATE_READY;
+		if(spi_touch){
+			touch.handle_dma_cb();
+			++touch_bursts;
+			if(touch_bursts > 1 && pen_down){
+				max_touch_gap = std::max(max_touch_gap, sim_t - last_touch_burst);
+			}
+			last_touch_burst = sim_t;
+			touch_ready = true;
+			audio_ready = true; // the shared bus is free again
+		}else{
+			audio_out.handle_dma_cb();
+			++chunks;
+			audio_ready = true;
+			touch_ready = true; // a burst held off by the chunk goes now
+		}
+	}
+
+	if(sim_t == PRESS_AT){
+		pen_down = true;
+		if(EXTI->IMR1 & GPIO_PIN_7){
+			touch.handle_penirq();
+			touch_ready = true;
+		}
+	}else if(sim_t == RELEASE_AT){
+		pen_down = false;
+	}else if(sim_t == PAUSE_AT){
+		audio_out.pause();
+	}else if(sim_t == PLAY_AT){
+		audio_out.play();
+	}
+
+	if(sim_t % AUDIO_PERIOD == 0){
+		audio_ready = true;
+	}
+	if(sim_t % TOUCH_PERIOD == 0){
+		touch_ready = true;
+	}
+	if(sim_t >= busy_until){
+		if(service_pending){
+			service_pending = false;
+			audio_out.service();
+		}
+		if(audio_ready){
+			audio_ready = false;
+			audio_task();
+		}else if(touch_ready){
+			touch_ready = false;
+			touch_task();
+		}
+	}
+}
+
+int main(){
+	bench_gpiod.ODR = A_CS_Pin; // A_CS comes up deasserted, T_CS low until Touch::init()
+	hspi2.State = HAL_SPI_STATE_READY;
+	touch.init(&hspi2);
+	audio_out.init(&hspi2);
+	fill(audio_out.get_consumer());
+	fill(audio_out.get_producer());
+	audio_out.start();
+
+	uint32_t min_fill = Fpga::DEPTH;
+	uint32_t max_fill = 0;
+	uint32_t underruns_at_pause = 0;
+	uint32_t underruns_at_play = 0;
+	for(sim_t = 0; sim_t < END_AT; sim_t += FPGA_CLK){
+		step();
+
+		if(sim_t == PAUSE_AT){
+			underruns_at_pause = fpga.underruns;
+		}else if(sim_t == PLAY_AT){
+			underruns_at_play = fpga.underruns;
+		}
+		// while the song is streaming, not around the pause and the end
+		bool streaming = (sim_t > WARMUP && sim_t < PAUSE_AT) ||
+				(sim_t > PLAY_AT + WARMUP && produced < SONG_SAMPLES);
+		if(streaming){
+			min_fill = std::min(min_fill, fpga.fill());
+			max_fill = std::max(max_fill, fpga.fill());
+		}
+	}
+
+	uint32_t wrong = 0;
+	for(uint32_t k = 0; k < fpga.played.size(); ++k){
+		if(k >= SONG_SAMPLES || fpga.played[k] != song_sample(k)){
+			++wrong;
+		}
+	}
+
+	printf("samples played %zu of %u, %u wrong\n", fpga.played.size(), SONG_SAMPLES, wrong);
+	printf("chunks %u, words dropped on a full FIFO %u\n", chunks, fpga.dropped);
+	printf("fifo fill while streaming %u to %u\n", min_fill, max_fill);
+	printf("underruns before the pause %u, after it %u, after the song %u\n", underruns_at_pause,
+			underruns_at_play, fpga.underruns);
+	printf("touch bursts %u, longest gap %.1fms, chip select errors %u\n", touch_bursts,
+			max_touch_gap / static_cast<double>(MS), cs_errors);
+
+	bool ok = fpga.played.size() == SONG_SAMPLES && wrong == 0 && fpga.dropped == 0 && min_fill > 0 &&
+			underruns_at_pause == 0 && underruns_at_play == 1 && fpga.underruns == 2 &&
+			touch_bursts >= MIN_TOUCH_BURSTS && cs_errors == 0;
+	printf("%s\n", ok ? "PASS" : "FAIL");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Just enough of the STM32 HAL for the audio headers to build on the host, picked up through the firmware's
+// main.h (inside its extern "C", so only C headers here).
+// DWT->CYCCNT counts host nanoseconds like in gimbal_sim, so the cycle stats come out in ns.
+// The GPIO and SPI functions are implemented by fpga_sim. TimAudioOut only has to compile, its TIM and DMA
+// calls are macros that drop their arguments.
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+typedef enum {
+	HAL_OK = 0x00,
+	HAL_ERROR = 0x01,
+	HAL_BUSY = 0x02,
+	HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+typedef struct {
+	uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef bench_gpioa, bench_gpiod, bench_gpiof;
+#define GPIOA (&bench_gpioa)
+#define GPIOD (&bench_gpiod)
+#define GPIOF (&bench_gpiof)
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_7 ((uint16_t)0x0080)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+
+typedef struct {
+	uint32_t IMR1;
+} EXTI_TypeDef;
+
+extern EXTI_TypeDef bench_exti;
+#define EXTI (&bench_exti)
+#define __HAL_GPIO_EXTI_CLEAR_IT(pin) ((void)(pin))
+
+typedef enum {
+	HAL_SPI_STATE_RESET = 0x00,
+	HAL_SPI_STATE_READY = 0x01,
+	HAL_SPI_STATE_BUSY_TX = 0x03,
+	HAL_SPI_STATE_BUSY_TX_RX = 0x05
+} HAL_SPI_StateTypeDef;
+
+typedef struct {
+	volatile HAL_SPI_StateTypeDef State;
+} SPI_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size);
+
+typedef struct {
+	uint32_t CCR1;
+	uint32_t ARR;
+} TIM_TypeDef;
+
+typedef struct {
+	TIM_TypeDef* Instance;
+} TIM_HandleTypeDef;
+
+typedef struct {
+	uint32_t unused;
+} DMA_HandleTypeDef;
+
+#define TIM_CHANNEL_1 0x00000000U
+#define HAL_TIM_PWM_Start(...) HAL_OK
+#define HAL_TIM_PWM_Stop(...) HAL_OK
+#define __HAL_TIM_ENABLE_DMA(...)
+#define __HAL_TIM_DISABLE_DMA(...)
+#define HAL_DMA_RegisterCallback(...) HAL_OK
+#define HAL_DMA_Start_IT(...) HAL_OK
+#define HAL_DMA_Abort_IT(...) HAL_OK
+#define __HAL_DMA_GET_COUNTER(...) 0
+
+struct bench_cyccnt {
+	operator uint32_t() const {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<uint32_t>(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+	}
+};
+
+typedef struct {
+	bench_cyccnt CYCCNT;
+} DWT_Type;
+
+extern DWT_Type bench_dwt;
+#define DWT (&bench_dwt)
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# Renders TTF fonts into run length compressed 1 bit atlases for the firmware.
+# Run from this folder, the header is written straight into the firmware includes:
+#   python3 gen_font.py
+
+from PIL import Image, ImageDraw, ImageFont
+from fontTools.ttLib import TTFont
+from pathlib import Path
+
+OUTPUT_PATH = Path("../fw/hearmeout/Core/Inc/font_data.hpp")
+
+# printable ASCII, the firmware builds its char -> glyph lookup from this same string
+CHARSET = "".join(chr(c) for c in range(32, 127))
+
+# (name used in the firmware, ttf file, pixel size)
+FONTS = [
+    ("LABEL", "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf", 20),
+    ("SMALL", "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 14),
+]
+
+MAX_RUN = 128 # each RLE byte holds the pixel value in bit 7 and run length - 1 in bits 6..0
+THRESHOLD = 128
+
+
+def rle_encode(bits):
+    out = []
+    i = 0
+    while i < len(bits):
+        value = bits[i]
+        run = 1
+        while i + run < len(bits) and bits[i + run] == value and run < MAX_RUN:
+            run += 1
+        out.append((value << 7) | (run - 1))
+        i += run
+    return out
+
+
+def render_glyph(font, c):
+    ascent, descent = font.getmetrics()
+    advance = round(font.getlength(c))
+    left, top, right, bottom = font.getbbox(c, anchor="la")
+    w = max(right - left, 0)
+    h = max(bottom - top, 0)
+    if w == 0 or h == 0:
+        return {"advance": advance, "w": 0, "h": 0, "x_off": 0, "y_off": 0, "bits": []}
+
+    img = Image.new("L", (w, h), 0)
+    ImageDraw.Draw(img).text((-left, -top), c, font=font, fill=255, anchor="la")
+    bits = [1 if img.getpixel((x, y)) >= THRESHOLD else 0 for y in range(h) for x in range(w)]
+    return {"advance": advance, "w": w, "h": h, "x_off": left, "y_off": top, "bits": bits}
+
+
+def kerning_pairs(path, size):
+    # reads the legacy kern table and scales it to pixels, pairs that round to 0 are dropped
+    tt = TTFont(path)
+    if "kern" not in tt:
+        return []
+    cmap = tt.getBestCmap()
+    scale = size / tt["head"].unitsPerEm
+    table = {}
+    for sub_table in tt["kern"].kernTables:
+        table.update(sub_table.kernTable)
+
+    pairs = []
+    for a in CHARSET:
+        for b in CHARSET:
+            value = table.get((cmap.get(ord(a)), cmap.get(ord(b))), 0)
+            adjust = round(value * scale)
+            if adjust != 0:
+                pairs.append((ord(a), ord(b), max(-128, min(127, adjust))))
+    return pairs
+
+
+def emit_font(name, path, size):
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    lower = name.lower()
+
+    rle = []
+    glyph_lines = []
+    for c in CHARSET:
+        g = render_glyph(font, c)
+        offset = len(rle)
+        rle += rle_encode(g["bits"])
+        glyph_lines.append(f"\t{{{offset}, {g['w']}, {g['h']}, {g['x_off']}, {g['y_off']}, {g['advance']}}}, // {c!r}")
+
+    kerns = kerning_pairs(path, size)
+
+    lines = []
+    lines.append(f"// {Path(path).name} {size}px, {len(rle)} bytes of glyph data")
+    lines.append(f"constexpr uint8_t {lower}_rle[] = {{")
+    for i in range(0, len(rle), 16):
+        lines.append("\t" + ", ".join(f"0x{b:02X}" for b in rle[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"constexpr Glyph {lower}_glyphs[] = {{")
+    lines += glyph_lines
+    lines.append("};")
+    lines.append("")
+    lines.append(f"constexpr Kern {lower}_kerns[] = {{")
+    for a, b, adjust in kerns:
+        lines.append(f"\t{{{a}, {b}, {adjust}}},")
+    if not kerns:
+        lines.append("\t{0, 0, 0},")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"constexpr Font FONT_{name}{{{lower}_rle, {lower}_glyphs, {lower}_kerns, {len(kerns)}, &FONT_GLYPH_INDEX, {ascent + descent}}};")
+    lines.append("")
+    return lines
+
+
+def main():
+    escaped = CHARSET.replace("\\", "\\\\").replace('"', '\\"')
+    lines = [
+        "/*",
+        " * Generated by fonts/gen_font.py, do not edit by hand",
+        " */",
+        "#pragma once",
+        "",
+        f"constexpr char FONT_CHARSET[] = \"{escaped}\";",
+        "constexpr GlyphIndex FONT_GLYPH_INDEX = make_glyph_index(FONT_CHARSET);",
+        "",
+    ]
+    for name, path, size in FONTS:
+        lines += emit_font(name, path, size)
+        print(f"Rendered {name} from {path} at {size}px...")
+
+    OUTPUT_PATH.write_text("\n".join(lines))
+    print(f"Wrote {OUTPUT_PATH}")
+
+
+if __name__ == "__main__":
+    main()
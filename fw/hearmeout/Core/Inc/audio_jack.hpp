@@ -1,32 +1,202 @@
 /*
- * Class for handling SD data transfers and DMA with CCR
+ * Class for sampling the audio jack into the same output buffers the SD card fills
  */
+#pragma once
+
+#include "main.h"
+#include "audio_out.hpp"
+#include <cstdio>
 
 #define MAX_ADC_VAL 4096
 
 class AudioJack {
 private:
+	static constexpr uint32_t BLOCK_SIZE = 256; // samples per DMA half, one interrupt every 6.4ms at 40kHz
+	static constexpr uint32_t RING_SIZE = 2 * BUFFER_SIZE; // both output buffers in the order they are played
+	static constexpr uint32_t LEAD = BUFFER_SIZE; // how far ahead of the output a block is written, in samples
+	static constexpr uint8_t ADC_BITS = 12;
+	static constexpr uint8_t SAMPLE_BITS = 16; // what the block path and the wav data use
+	// at 24.5 cycle sampling a conversion takes 1.2us, so 16 of them are as many as fit in the 25us sample period
+	static constexpr uint8_t MAX_RATIO_LOG2 = 4;
+	static constexpr uint8_t DC_POLE_SHIFT = 8; // pole at 1 - 2^-8, a 25Hz corner at 40kHz
+
 	// audio jack adc
 	ADC_HandleTypeDef* audio_jack_adc;
 
 	// audio jack opamp
 	OPAMP_HandleTypeDef* audio_amp;
 
+	// TIM1, its update triggers every conversion so the input runs at exactly the output rate
+	TIM_HandleTypeDef* trigger_tim;
+
+	// TIM2, the EN PWM the passthrough DMA writes straight into
+	TIM_HandleTypeDef* pwm_tim;
+
+	AudioOut* out;
+
+	uint16_t adc_buf[2 * BLOCK_SIZE]; // circular DMA, a block is ready at each half
+	uint16_t* ring[2]; // output buffer that was playing when the jack started, then the other one
+	volatile uint32_t blocks_done; // counted by the DMA callbacks
+	uint32_t blocks_read;
+	uint32_t write_pos; // ring position of the next sample
+	uint32_t overruns;
+	bool running;
+
+	// passthrough, every conversion goes by DMA from the ADC to the EN duty without the CPU
+	bool passthrough;
+	volatile bool measuring; // the next end of conversion interrupt samples trigger_tim
+	volatile uint32_t trigger_counts; // trigger_tim counts from the trigger to the end of the conversion
+	uint32_t latency_samples; // block path, newest sample to when it is output
+	uint32_t worst_latency_samples;
+
+	// block path oversampling, the ADC sums 2^ratio_log2 conversions per trigger and shifts the sum right
+	uint8_t ratio_log2;
+	uint8_t right_shift;
+	uint8_t sample_shift; // left shift from the ADC result up to SAMPLE_BITS
+
+	// DC blocker, y = x - x[n-1] + (1 - 2^-DC_POLE_SHIFT) y[n-1] with y in Q8
+	bool dc_seeded; // the first sample after starting sets x[n-1] so the offset does not thump
+	int32_t dc_x;
+	int32_t dc_y_q8;
+
 	// requests
 	bool requested_play;
 	bool requested_pause;
+	bool requested_toggle;
+
+	void fill_silence(){
+		for(uint32_t i = 0; i < BUFFER_SIZE; i++){
+			out->get_consumer()[i] = AudioOut::SILENCE;
+			out->get_producer()[i] = AudioOut::SILENCE;
+		}
+	}
+
+	// removes the DC from the oversampled samples, leaving 16 bit signed ones like the wav data, and converts them
+	// in place in the ring
+	void write_block(uint16_t const* src){
+		if(!dc_seeded){
+			dc_seeded = true;
+			dc_x = static_cast<int32_t>(src[0]) << sample_shift;
+			dc_y_q8 = 0;
+		}
+		uint32_t i = 0;
+		while(i < BLOCK_SIZE){
+			uint32_t pos = write_pos % BUFFER_SIZE;
+			uint32_t n = BUFFER_SIZE - pos < BLOCK_SIZE - i ? BUFFER_SIZE - pos : BLOCK_SIZE - i;
+			uint16_t* dst = ring[write_pos / BUFFER_SIZE] + pos;
+			for(uint32_t k = 0; k < n; k++){
+				int32_t x = static_cast<int32_t>(src[i + k]) << sample_shift;
+				dc_y_q8 += ((x - dc_x) << 8) - (dc_y_q8 >> DC_POLE_SHIFT);
+				dc_x = x;
+				int32_t y = dc_y_q8 >> 8;
+				y = y > INT16_MAX ? INT16_MAX : (y < INT16_MIN ? INT16_MIN : y);
+				dst[k] = static_cast<uint16_t>(y);
+			}
+			out->convert(dst, n);
+			i += n;
+			write_pos = (write_pos + n) % RING_SIZE;
+		}
+	}
+
+	// ring position of the sample the output is playing
+	uint32_t output_pos(){
+		return (out->get_consumer() == ring[0] ? 0 : BUFFER_SIZE) + out->get_play_pos();
+	}
+
+	// block samples are oversampled by ratio_log2 and right_shift into memory. passthrough samples are averaged 4x
+	// and shifted to 10 bits, 0 - 1023, the largest power of two range that fits the TIM2 ARR of 1499, and go to
+	// one register. both run the whole oversampling on each trigger, all in the ADC
+	void configure(bool passthrough_in){
+		passthrough = passthrough_in;
+		uint8_t ratio = passthrough ? 2 : ratio_log2;
+		uint8_t shift = passthrough ? 4 : right_shift;
+		audio_jack_adc->Init.OversamplingMode = ratio ? ENABLE : DISABLE;
+		audio_jack_adc->Init.Oversampling.Ratio = ratio ? (ratio - 1) << ADC_CFGR2_OVSR_Pos : 0;
+		audio_jack_adc->Init.Oversampling.RightBitShift = shift << ADC_CFGR2_OVSS_Pos;
+		audio_jack_adc->Init.Oversampling.TriggeredMode = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
+		audio_jack_adc->Init.Oversampling.OversamplingStopReset = ADC_REGOVERSAMPLING_CONTINUED_MODE;
+		sample_shift = SAMPLE_BITS - (ADC_BITS + ratio_log2 - right_shift);
+		if(HAL_ADC_Init(audio_jack_adc) != HAL_OK){
+			printf("Error configuring audio jack ADC\r\n");
+		}
+		// offset calibration, with the ADC disabled and once per init since leaving deep power down loses it
+		if(HAL_ADCEx_Calibration_Start(audio_jack_adc, ADC_SINGLE_ENDED) != HAL_OK){
+			printf("Error calibrating audio jack ADC\r\n");
+		}
+
+		// the CCR is a word, the DMA zero extends each half word sample into it
+		DMA_HandleTypeDef* dma = audio_jack_adc->DMA_Handle;
+		dma->Init.MemInc = passthrough ? DMA_MINC_DISABLE : DMA_MINC_ENABLE;
+		dma->Init.MemDataAlignment = passthrough ? DMA_MDATAALIGN_WORD : DMA_MDATAALIGN_HALFWORD;
+		if(HAL_DMA_Init(dma) != HAL_OK){
+			printf("Error configuring audio jack DMA\r\n");
+		}
+	}
+
+	// the SD path's DMA into CCR1 is paused and the ADC DMA takes over the register, no interrupts at all
+	bool start_passthrough(){
+#if USE_FPGA_AUDIO
+		printf("Passthrough needs the TIM1 / TIM2 output\r\n");
+		return false;
+#else
+		fill_silence();
+		if(!out->is_running()){
+			out->start();
+		}
+		out->pause();
+		DMA_HandleTypeDef* dma = audio_jack_adc->DMA_Handle;
+		if(HAL_DMA_Start(dma, (uint32_t)&audio_jack_adc->Instance->DR, (uint32_t)&pwm_tim->Instance->CCR1, 1) != HAL_OK){
+			printf("Error starting audio jack passthrough\r\n");
+			return false;
+		}
+		SET_BIT(audio_jack_adc->Instance->CFGR, ADC_CFGR_DMAEN | ADC_CFGR_DMACFG);
+		if(HAL_ADC_Start(audio_jack_adc) != HAL_OK){
+			printf("Error starting audio jack ADC\r\n");
+			HAL_DMA_Abort(dma);
+			return false;
+		}
+		__HAL_TIM_ENABLE(trigger_tim);
+		return true;
+#endif
+	}
+
+	void stop_passthrough(){
+		HAL_ADC_Stop(audio_jack_adc);
+		CLEAR_BIT(audio_jack_adc->Instance->CFGR, ADC_CFGR_DMAEN | ADC_CFGR_DMACFG);
+		HAL_DMA_Abort(audio_jack_adc->DMA_Handle);
+		__HAL_ADC_DISABLE_IT(audio_jack_adc, ADC_IT_EOS);
+		measuring = false;
+		__HAL_TIM_SET_COMPARE(pwm_tim, TIM_CHANNEL_1, AudioOut::SILENCE);
+	}
 
 public:
 	AudioJack() = default;
 
-	void init (ADC_HandleTypeDef* audio_jack_adc_in, OPAMP_HandleTypeDef* audio_amp_in) {
+	void init (ADC_HandleTypeDef* audio_jack_adc_in, OPAMP_HandleTypeDef* audio_amp_in, TIM_HandleTypeDef* trigger_tim_in,
+			TIM_HandleTypeDef* pwm_tim_in, AudioOut* out_in) {
 		audio_jack_adc = audio_jack_adc_in;
 		audio_amp = audio_amp_in;
+		trigger_tim = trigger_tim_in;
+		pwm_tim = pwm_tim_in;
+		out = out_in;
+		running = false;
+		overruns = 0;
+		passthrough = false;
+		measuring = false;
+		trigger_counts = 0;
+		latency_samples = 0;
+		worst_latency_samples = 0;
+		requested_play = false;
+		requested_pause = false;
+		requested_toggle = false;
+		ratio_log2 = MAX_RATIO_LOG2; // 12 bits x 16, a full 16 bit sample
+		right_shift = 0;
+		configure(false);
 
 		// initialize the audio jack amp
 		HAL_OPAMP_Start(audio_amp);
 
-		// dont start the ADC interrupts here because we will default to not reading from the audio jack
+		// dont start the ADC here because we will default to not reading from the audio jack
 	}
 
 	void request_play(){
@@ -37,15 +207,82 @@ public:
 		requested_pause = true;
 	}
 
+	// block path oversampling, 2^ratio_log2 conversions summed per sample and shifted right, false if the sum
+	// would not fit in 16 bits or take longer than a sample period. only while the jack is paused
+	bool set_oversampling(uint8_t ratio_log2_in, uint8_t right_shift_in){
+		if(running || ratio_log2_in > MAX_RATIO_LOG2 || right_shift_in > 8 ||
+				ADC_BITS + ratio_log2_in < right_shift_in || ADC_BITS + ratio_log2_in - right_shift_in > SAMPLE_BITS)
+			return false;
+		ratio_log2 = ratio_log2_in;
+		right_shift = right_shift_in;
+		configure(passthrough);
+		return true;
+	}
+
+	// switches between the block path and passthrough, applied by check_next()
+	void request_toggle_passthrough(){
+		requested_toggle = true;
+	}
+
+	// takes over the output, which plays silence until the first block is written LEAD samples ahead of it
 	void play(){
-		HAL_ADC_Start_IT(audio_jack_adc);
+		if(running)
+			return;
+		if(passthrough){
+			running = start_passthrough();
+			return;
+		}
+#if USE_FPGA_AUDIO
+		// TIM1 clocks the ADC but the FPGA plays from its own oscillator, the ring has no way to take up the drift
+		printf("Block processing needs the TIM1 / TIM2 output\r\n");
+#else
+		fill_silence();
+		if(!out->is_running()){
+			out->start();
+		}
+		ring[0] = out->get_consumer();
+		ring[1] = out->get_producer();
+		write_pos = (out->get_play_pos() + LEAD) % RING_SIZE;
+		out->play();
+
+		blocks_done = 0;
+		blocks_read = 0;
+		dc_seeded = false;
+		if(HAL_ADC_Start_DMA(audio_jack_adc, reinterpret_cast<uint32_t*>(adc_buf), 2 * BLOCK_SIZE) != HAL_OK){
+			printf("Error starting audio jack ADC\r\n");
+			out->pause();
+			return;
+		}
+		running = true;
+#endif
 	}
 
+	// the buffers are left silent for whichever source plays next
 	void pause(){
-		HAL_ADC_Stop_IT(audio_jack_adc);
+		if(!running)
+			return;
+		running = false;
+		if(passthrough){
+			stop_passthrough();
+			return;
+		}
+		HAL_ADC_Stop_DMA(audio_jack_adc);
+		out->pause();
+		fill_silence();
 	}
 
 	void check_next(){
+		if(requested_toggle){
+			requested_toggle = false;
+			bool was_running = running;
+			pause();
+			configure(!passthrough);
+			worst_latency_samples = 0;
+			printf("Audio jack %s\r\n", passthrough ? "passthrough" : "block processing");
+			if(was_running){
+				play();
+			}
+		}
 		if(requested_play){
 			requested_play = false;
 			play();
@@ -54,4 +291,65 @@ public:
 			pause();
 		}
 	}
+
+	// called from the ADC half and full DMA callbacks and, while measuring passthrough latency, the end of
+	// conversion interrupt. true if a block is ready for service()
+	bool handle_dma_cb(){
+		if(passthrough){
+			if(measuring){
+				trigger_counts = __HAL_TIM_GET_COUNTER(trigger_tim);
+				__HAL_ADC_DISABLE_IT(audio_jack_adc, ADC_IT_EOS);
+				measuring = false;
+			}
+			return false;
+		}
+		++blocks_done;
+		return true;
+	}
+
+	// copies the finished blocks into the output, called by main driver after each block. the ring is written
+	// ahead of the output rather than a buffer at a time, so the refills the output asks for are only cleared
+	void service(){
+		if(!running || passthrough)
+			return;
+		uint32_t done = blocks_done;
+		// the DMA is already writing over the oldest of two unread blocks
+		if(done - blocks_read > 1){
+			overruns += done - blocks_read - 1;
+			blocks_read = done - 1;
+			printf("Audio jack overrun, %lu blocks dropped\r\n", overruns);
+		}
+		while(blocks_read != done){
+			write_block(adc_buf + (blocks_read % 2) * BLOCK_SIZE);
+			++blocks_read;
+		}
+		if(out->refill_pending()){
+			out->refilled();
+		}
+
+		// the newest sample was taken as many samples ago as the DMA has written into the next block, and is
+		// played once the output reaches where it was written
+		uint32_t age = (2 * BLOCK_SIZE - __HAL_DMA_GET_COUNTER(audio_jack_adc->DMA_Handle)) % BLOCK_SIZE;
+		latency_samples = age + (write_pos - 1 - output_pos() + RING_SIZE) % RING_SIZE;
+		if(latency_samples > worst_latency_samples) worst_latency_samples = latency_samples;
+	}
+
+	// prints the measured input to output latency of whichever path is running, called by main driver
+	void report(){
+		if(!running)
+			return;
+		uint32_t counts_per_us = SystemCoreClock / 1000000; // TIM1 and TIM2 run at the core clock
+		if(passthrough){
+			// the CCR is preloaded, so the new duty starts at the next TIM2 update
+			uint32_t pwm_ns = (__HAL_TIM_GET_AUTORELOAD(pwm_tim) + 1) * 1000 / counts_per_us;
+			printf("aux passthrough: %luns to CCR1, output within %luns more\r\n",
+					trigger_counts * 1000 / counts_per_us, pwm_ns);
+			measuring = true;
+			__HAL_ADC_ENABLE_IT(audio_jack_adc, ADC_IT_EOS);
+		}else{
+			uint32_t sample_ns = (__HAL_TIM_GET_AUTORELOAD(trigger_tim) + 1) * 1000 / counts_per_us;
+			printf("aux blocks: %luus latency (worst %luus)\r\n", latency_samples * sample_ns / 1000,
+					worst_latency_samples * sample_ns / 1000);
+		}
+	}
 };
@@ -0,0 +1,300 @@
+/*
+ * Output backends for the SD card audio, both double buffer BUFFER_SIZE samples that SD fills from the wav file
+ */
+#pragma once
+
+#include "main.h"
+#include "equalizer.hpp"
+#include "modulator.hpp"
+#include <cstdio>
+
+// set to 1 to stream the samples to the FPGA, which generates DIR and EN itself, instead of using TIM1 / TIM2
+#ifndef USE_FPGA_AUDIO
+#define USE_FPGA_AUDIO 0
+#endif
+
+#define BUFFER_SIZE 1024
+
+// DIR from TIM1 at the sample rate, its update DMA writes the next sample into the EN PWM duty on TIM2
+class TimAudioOut {
+private:
+	uint16_t buffer1[BUFFER_SIZE];
+	uint16_t buffer2[BUFFER_SIZE];
+	uint16_t* consumer_buf; // buffer currently being consumed by CCR
+	uint16_t* producer_buf; // buffer being filled from the SD card
+
+	TIM_HandleTypeDef* htim1_DIR; // pointer to timer handle for transducers
+	TIM_HandleTypeDef* htim2_EN; // pointer to timer handle for transducers
+	DMA_HandleTypeDef* hdma_ptr; // pointer to dma handle for tim up
+	volatile bool need_refill; // bool that represents if a refill is needed for producer_buf
+	bool running;
+	Equalizer eq; // runs on every buffer before it is rescaled
+	Modulator mod; // turns the equalized samples into the carrier envelope
+
+public:
+	// CCR 0 keeps EN off
+	static constexpr uint16_t SILENCE = 0;
+
+	TimAudioOut() = default;
+
+	//htim1 --> 40kHz square wave PWM generation to toggle DIR that triggers DMA to put buff[s] --> htim2_CCR
+	//htim2 --> 80kHz modulated PWM
+	void init(TIM_HandleTypeDef* htim1_in, TIM_HandleTypeDef* htim2_in, DMA_HandleTypeDef* hdma_in){
+		htim1_DIR = htim1_in;
+		htim2_EN = htim2_in;
+		hdma_ptr = hdma_in;
+		need_refill = false;
+		running = false;
+		consumer_buf = buffer1;
+		producer_buf = buffer2;
+		eq.init();
+		mod.init();
+	}
+
+	// equalizes the input, shapes it into the envelope and resamples it to be a 16 bit unsigned int with value
+	// from 0 to ARR
+	void convert(uint16_t* buf, uint32_t samples){
+		eq.process(buf, samples);
+		mod.process(buf, samples);
+		uint32_t arr = htim2_EN->Instance->ARR;
+		for(uint32_t i = 0; i < samples; i++){
+			uint32_t u16 = static_cast<int16_t>(buf[i]) + 32768;
+			buf[i] = static_cast<uint16_t>((u16 * arr) >> 16);
+		}
+	}
+
+	uint16_t* get_consumer(){
+		return consumer_buf;
+	}
+
+	uint16_t* get_producer(){
+		return producer_buf;
+	}
+
+	// starts both timers and the DMA once both buffers are filled
+	void start(){
+		//set DIR to be a 40kHz sq wave (ARR = 2999, CCR = 1499)
+		htim1_DIR->Instance->CCR1 = 1499;
+
+		//start the direction PWM timer (40kHz square wave)
+		HAL_TIM_PWM_Start(htim1_DIR, TIM_CHANNEL_1);
+		//start the EN PWM timer (80kHz modulated wave)
+		HAL_TIM_PWM_Start(htim2_EN, TIM_CHANNEL_1);
+
+		__HAL_TIM_ENABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+
+		HAL_DMA_RegisterCallback(hdma_ptr, HAL_DMA_XFER_CPLT_CB_ID, HAL_DMA_XferCpltCallback);
+		HAL_DMA_Start_IT(hdma_ptr, (uint32_t)consumer_buf, (uint32_t)(&htim2_EN->Instance->CCR1), BUFFER_SIZE);
+		running = true;
+	}
+
+	void stop(){
+		running = false;
+		HAL_DMA_Abort_IT(hdma_ptr);
+		__HAL_TIM_DISABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+		HAL_TIM_PWM_Stop(htim1_DIR, TIM_CHANNEL_1);
+		HAL_TIM_PWM_Stop(htim2_EN, TIM_CHANNEL_1);
+	}
+
+	void pause(){
+		__HAL_TIM_DISABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+	}
+
+	void play(){
+		__HAL_TIM_ENABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+	}
+
+	// this function gets called when a buffer is emptied
+	void handle_dma_cb(){
+		//swap buffers
+		uint16_t* temp_buf = consumer_buf;
+		consumer_buf = producer_buf;
+		producer_buf = temp_buf;
+
+		// launch next DMA on the new consumer_buf
+		HAL_DMA_Start_IT(hdma_ptr, (uint32_t)consumer_buf, (uint32_t)&htim2_EN->Instance->CCR1, BUFFER_SIZE);
+
+		//signal to refil the (now empty) producerbuffer
+		need_refill = true;
+	}
+
+	// nothing to do from the main loop, the DMA runs off TIM1
+	void service(){
+	}
+
+	bool is_running() const {
+		return running;
+	}
+
+	// samples of the consumer buffer already output
+	uint32_t get_play_pos(){
+		return BUFFER_SIZE - __HAL_DMA_GET_COUNTER(hdma_ptr);
+	}
+
+	bool refill_pending() const {
+		return need_refill;
+	}
+
+	void refilled(){
+		need_refill = false;
+	}
+
+	Equalizer& get_eq(){
+		return eq;
+	}
+
+	Modulator& get_mod(){
+		return mod;
+	}
+};
+
+// raw samples go over SPI to the FIFO in the FPGA, which paces them and raises DRQ when half empty. the bus
+// is shared with the touch controller, whoever finds it idle takes it for one transfer
+class FpgaAudioOut {
+private:
+	static constexpr uint32_t CHUNK_SAMPLES = 512; // half the FPGA FIFO, all the room DRQ promises
+	static constexpr uint32_t CHUNKS_PER_BUFFER = BUFFER_SIZE / CHUNK_SAMPLES;
+
+	uint16_t buffer1[BUFFER_SIZE];
+	uint16_t buffer2[BUFFER_SIZE];
+	uint16_t* consumer_buf; // buffer currently being streamed
+	uint16_t* producer_buf; // buffer being filled from the SD card
+	uint32_t chunk; // next chunk of consumer_buf to send
+
+	SPI_HandleTypeDef* spi;
+	volatile bool sending;
+	volatile bool need_refill;
+	bool running;
+	bool paused;
+	Equalizer eq;
+	Modulator mod;
+
+	void cs_low(){
+		HAL_GPIO_WritePin(A_CS_GPIO_Port, A_CS_Pin, GPIO_PIN_RESET);
+	}
+
+	void cs_high(){
+		HAL_GPIO_WritePin(A_CS_GPIO_Port, A_CS_Pin, GPIO_PIN_SET);
+	}
+
+public:
+	// offset binary 0 on the FPGA side, keeps EN off
+	static constexpr uint16_t SILENCE = 0x8000;
+
+	FpgaAudioOut() = default;
+
+	void init(SPI_HandleTypeDef* spi_in){
+		spi = spi_in;
+		consumer_buf = buffer1;
+		producer_buf = buffer2;
+		chunk = 0;
+		sending = false;
+		need_refill = false;
+		running = false;
+		paused = false;
+		eq.init();
+		mod.init();
+		cs_high();
+	}
+
+	// the FPGA takes the envelope samples as they are, low byte first
+	void convert(uint16_t* buf, uint32_t samples){
+		eq.process(buf, samples);
+		mod.process(buf, samples);
+	}
+
+	uint16_t* get_consumer(){
+		return consumer_buf;
+	}
+
+	uint16_t* get_producer(){
+		return producer_buf;
+	}
+
+	// like the timers restarting, a new song also ends a pause
+	void start(){
+		chunk = 0;
+		running = true;
+		paused = false;
+		service();
+	}
+
+	// the FIFO drains and the FPGA turns the carrier off on its own
+	void stop(){
+		running = false;
+	}
+
+	void pause(){
+		paused = true;
+	}
+
+	void play(){
+		paused = false;
+		service();
+	}
+
+	// called from HAL_SPI_TxCpltCallback when a chunk has been sent
+	void handle_dma_cb(){
+		cs_high();
+		if(++chunk == CHUNKS_PER_BUFFER){
+			chunk = 0;
+			uint16_t* temp_buf = consumer_buf;
+			consumer_buf = producer_buf;
+			producer_buf = temp_buf;
+			need_refill = true;
+		}
+		sending = false;
+	}
+
+	// sends the next chunk when the FPGA asks for it and the bus is free, called by main driver on DRQ and
+	// after each chunk
+	void service(){
+		if(!running || paused || sending || HAL_GPIO_ReadPin(A_DRQ_GPIO_Port, A_DRQ_Pin) == GPIO_PIN_RESET){
+			return;
+		}
+		// the touch controller has the bus, the next touch callback or audio tick tries again
+		if(spi->State != HAL_SPI_STATE_READY){
+			return;
+		}
+
+		sending = true;
+		cs_low();
+		uint8_t* data = reinterpret_cast<uint8_t*>(consumer_buf + chunk * CHUNK_SAMPLES);
+		if(HAL_SPI_Transmit_DMA(spi, data, CHUNK_SAMPLES * sizeof(uint16_t)) != HAL_OK){
+			printf("Error starting audio DMA\r\n");
+			cs_high();
+			sending = false;
+		}
+	}
+
+	bool is_running() const {
+		return running;
+	}
+
+	// samples of the consumer buffer already sent, the FPGA FIFO holds up to another chunk
+	uint32_t get_play_pos(){
+		return chunk * CHUNK_SAMPLES;
+	}
+
+	bool refill_pending() const {
+		return need_refill;
+	}
+
+	void refilled(){
+		need_refill = false;
+	}
+
+	Equalizer& get_eq(){
+		return eq;
+	}
+
+	Modulator& get_mod(){
+		return mod;
+	}
+};
+
+#if USE_FPGA_AUDIO
+using AudioOut = FpgaAudioOut;
+#else
+using AudioOut = TimAudioOut;
+#endif
@@ -0,0 +1,252 @@
+/*
+ * Class for one gimbal axis, a fixed point alpha-beta filter on where the target is in the image and a PID that
+ * moves the servo toward it, stepped once per camera tick
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdlib>
+
+class AxisTracker {
+public:
+	// all Q8. alpha and beta are the filter gains from 0 to 256, kp, ki and kd are in units of the servo move
+	// that would center the target in a single tick
+	struct Gains {
+		int32_t alpha;
+		int32_t beta;
+		int32_t kp;
+		int32_t ki;
+		int32_t kd;
+		uint32_t lead_ticks; // how far past the filtered position the PID aims, covers the camera latency
+	};
+
+	// geometry of the axis, positions are camera pixels and servo pulses are in us
+	struct Config {
+		int32_t center_q8; // pixel the target should sit on
+		int32_t sign; // 1 if a target at a larger pixel needs a longer pulse, -1 otherwise
+		int32_t ccr_per_px_q8; // servo move that shifts the target by one pixel
+		int32_t ccr_min;
+		int32_t ccr_max;
+		int32_t max_step; // largest move per tick
+		int32_t deadband_q8; // errors this small count as centered
+		uint32_t latency_ticks; // from a servo move until the frames the camera answers with show it
+	};
+
+	// how the last move settled, a move starts when the target is acquired or jumps more than MOVE_PX away
+	struct Metrics {
+		uint32_t settle_ms; // until the error stayed inside the deadband for SETTLED_TICKS
+		uint32_t overshoot_px; // furthest the target got past the center, on the other side from where it started
+		uint32_t worst_settle_ms;
+		uint32_t worst_overshoot_px;
+		uint32_t moves;
+	};
+
+private:
+	static constexpr int32_t MOVE_PX = 20;
+	static constexpr uint32_t SETTLED_TICKS = 10;
+	static constexpr int32_t INTEGRAL_LIMIT_Q8 = 50 << 8; // pixel ticks
+	static constexpr uint32_t MAX_LATENCY_TICKS = 16;
+
+	Config cfg;
+	Gains gains;
+	uint32_t tick_ms;
+
+	// filter state, the error is how far the target is from center in the direction the servo has to move
+	bool locked; // false until the first measurement after losing the target
+	int32_t err_q8;
+	int32_t vel_q8; // pixels per tick
+	bool meas_pending;
+	int32_t meas_q8;
+	uint32_t ticks_since_meas;
+
+	// PID state
+	int32_t integral_q8;
+	int32_t prev_aim_q8;
+	int32_t ccr_q8;
+
+	// image shift of the moves made on the last MAX_LATENCY_TICKS ticks, a measurement does not see the newest
+	// latency_ticks of them yet
+	int32_t moves_q8[MAX_LATENCY_TICKS];
+	uint32_t move_idx;
+
+	// move currently being timed
+	bool settling;
+	bool start_positive;
+	uint32_t move_ticks;
+	uint32_t in_band_ticks;
+	int32_t overshoot_q8;
+	Metrics metrics;
+
+	static int32_t clamp(int32_t v, int32_t lo, int32_t hi){
+		return v < lo ? lo : (v > hi ? hi : v);
+	}
+
+	// the measurement as if the camera had already seen every move, err_q8 has had them all taken off
+	int32_t compensate(int32_t meas){
+		uint32_t n = cfg.latency_ticks < MAX_LATENCY_TICKS ? cfg.latency_ticks : MAX_LATENCY_TICKS;
+		for(uint32_t i = 1; i <= n; ++i){
+			meas -= moves_q8[(move_idx + MAX_LATENCY_TICKS - i) % MAX_LATENCY_TICKS];
+		}
+		return meas;
+	}
+
+	void start_move(){
+		settling = true;
+		start_positive = err_q8 > 0;
+		move_ticks = 0;
+		in_band_ticks = 0;
+		overshoot_q8 = 0;
+	}
+
+	void update_metrics(){
+		if(!settling){
+			if(abs(err_q8) > MOVE_PX << 8){
+				start_move();
+			}
+			return;
+		}
+
+		++move_ticks;
+		if((err_q8 > 0) != start_positive && abs(err_q8) > overshoot_q8){
+			overshoot_q8 = abs(err_q8);
+		}
+		if(abs(err_q8) > cfg.deadband_q8){
+			in_band_ticks = 0;
+			return;
+		}
+		if(++in_band_ticks < SETTLED_TICKS){
+			return;
+		}
+
+		settling = false;
+		metrics.settle_ms = (move_ticks - SETTLED_TICKS) * tick_ms;
+		metrics.overshoot_px = overshoot_q8 >> 8;
+		if(metrics.settle_ms > metrics.worst_settle_ms) metrics.worst_settle_ms = metrics.settle_ms;
+		if(metrics.overshoot_px > metrics.worst_overshoot_px) metrics.worst_overshoot_px = metrics.overshoot_px;
+		++metrics.moves;
+	}
+
+public:
+	AxisTracker() = default;
+
+	void init(Config const& cfg_in, Gains const& gains_in, uint32_t tick_ms_in, int32_t ccr){
+		cfg = cfg_in;
+		gains = gains_in;
+		tick_ms = tick_ms_in;
+		ccr_q8 = ccr << 8;
+		meas_pending = false;
+		metrics = {0, 0, 0, 0, 0};
+		lose();
+	}
+
+	void set_gains(Gains const& gains_in){
+		gains = gains_in;
+		integral_q8 = 0;
+	}
+
+	Gains const& get_gains() const {
+		return gains;
+	}
+
+	Metrics const& get_metrics() const {
+		return metrics;
+	}
+
+	Config const& get_config() const {
+		return cfg;
+	}
+
+	// direction and scale from a calibration, the filter starts over since its state was in the old scale
+	void set_geometry(int32_t sign, int32_t ccr_per_px_q8){
+		cfg.sign = sign;
+		cfg.ccr_per_px_q8 = ccr_per_px_q8;
+		lose();
+	}
+
+	// pulse the servo was last given
+	int32_t get_ccr() const {
+		return ccr_q8 >> 8;
+	}
+
+	// newest pixel the camera saw the target at, used on the next step()
+	void measure(uint16_t px){
+		meas_q8 = cfg.sign * ((static_cast<int32_t>(px) << 8) - cfg.center_q8);
+		meas_pending = true;
+	}
+
+	// target gone, the servo holds where it is until it shows up again
+	void lose(){
+		locked = false;
+		err_q8 = 0;
+		vel_q8 = 0;
+		integral_q8 = 0;
+		prev_aim_q8 = 0;
+		ticks_since_meas = 0;
+		settling = false;
+		for(uint32_t i = 0; i < MAX_LATENCY_TICKS; ++i){
+			moves_q8[i] = 0;
+		}
+		move_idx = 0;
+	}
+
+	// one control tick, returns the servo pulse to write
+	int32_t step(){
+		++ticks_since_meas;
+		if(locked){
+			// the target keeps moving at the estimated speed
+			err_q8 += vel_q8;
+		}
+
+		if(meas_pending){
+			meas_pending = false;
+			int32_t meas = compensate(meas_q8);
+			if(!locked){
+				locked = true;
+				err_q8 = meas;
+				prev_aim_q8 = meas;
+				if(abs(err_q8) > cfg.deadband_q8){
+					start_move();
+				}
+			}else{
+				int32_t residual = meas - err_q8;
+				err_q8 += (gains.alpha * residual) >> 8;
+				vel_q8 += ((gains.beta * residual) >> 8) / static_cast<int32_t>(ticks_since_meas);
+			}
+			ticks_since_meas = 0;
+		}
+
+		if(!locked){
+			return ccr_q8 >> 8;
+		}
+
+		// aim where the target will be once the camera sees the move
+		int32_t aim_q8 = err_q8 + vel_q8 * static_cast<int32_t>(gains.lead_ticks);
+		if(abs(aim_q8) <= cfg.deadband_q8){
+			aim_q8 = 0;
+		}
+		int32_t integral = clamp(integral_q8 + aim_q8, -INTEGRAL_LIMIT_Q8, INTEGRAL_LIMIT_Q8);
+		int32_t deriv_q8 = aim_q8 - prev_aim_q8;
+		prev_aim_q8 = aim_q8;
+
+		int32_t px_q8 = (gains.kp * aim_q8 + gains.ki * integral + gains.kd * deriv_q8) >> 8;
+		int32_t want_q8 = (px_q8 * cfg.ccr_per_px_q8) >> 8;
+		int32_t move_q8 = clamp(want_q8, -(cfg.max_step << 8), cfg.max_step << 8);
+		int32_t next_q8 = clamp(ccr_q8 + move_q8, cfg.ccr_min << 8, cfg.ccr_max << 8);
+		move_q8 = next_q8 - ccr_q8;
+		ccr_q8 = next_q8;
+		// the I term only builds while the servo can still follow, slewing at max_step would wind it up
+		if(move_q8 == want_q8){
+			integral_q8 = integral;
+		}
+
+		// moving the camera shifts the target in the image by the same amount, the measurements catch up with it
+		// latency_ticks later
+		int32_t shift_q8 = (move_q8 << 8) / cfg.ccr_per_px_q8;
+		err_q8 -= shift_q8;
+		moves_q8[move_idx] = shift_q8;
+		move_idx = (move_idx + 1) % MAX_LATENCY_TICKS;
+
+		update_metrics();
+		return ccr_q8 >> 8;
+	}
+};
@@ -0,0 +1,197 @@
+/*
+ * Cascaded biquad EQ run on every buffer just before the output converts it, so the SD card and the audio jack
+ * both go through it. Coefficients are fixed point, the presets are switched at runtime from the UI
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdio>
+
+// one stage, Direct Form I y = b0 x + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]. the a terms are stored
+// negated so every tap is a multiply accumulate. values are Q31 scaled down by 2^POST_SHIFT to reach +-2
+struct BiquadCoeffs {
+	int32_t b0;
+	int32_t b1;
+	int32_t b2;
+	int32_t a1;
+	int32_t a2;
+};
+
+class Equalizer {
+public:
+	enum PRESET : uint8_t {
+		FLAT = 0x0,
+		LOW_CUT = 0x1, // what resample_songs.sh used to bake in, two 250Hz high-passes
+		TRANSDUCER = 0x2, // tilts down the treble the air demodulation of the carrier boosts
+		LOUDNESS = 0x3, // low and high shelves for quiet listening
+		NUM_PRESETS = 0x4
+	};
+
+	static constexpr uint8_t MAX_STAGES = 4;
+	static constexpr uint8_t POST_SHIFT = 1;
+	// samples sit this far below Q31 full scale, a high-pass overshoots a full scale step and saturating inside
+	// the feedback makes it ring. it also keeps the five products from overflowing the accumulator
+	static constexpr uint8_t HEADROOM_BITS = 1;
+	// of the 3000 cycles per sample at 120MHz and 40kHz, 5% of the CPU
+	static constexpr uint32_t BUDGET_CYCLES_PER_SAMPLE = 150;
+
+private:
+	struct Preset {
+		char const* name;
+		uint8_t num_stages;
+		BiquadCoeffs stages[MAX_STAGES];
+	};
+
+	// RBJ cookbook designs for fs = 40kHz, Q 0.707 high-passes and slope 1 shelves. presets with a boost have
+	// their first stage scaled so the peak gain is 0dB and the filter cannot clip a full scale sine
+	static constexpr Preset PRESETS[NUM_PRESETS] = {
+		{"flat", 0, {}},
+		{"low cut", 2, {
+			{1044336221, -2088672443, 1044336221, 2087866987, -1015736075}, // high-pass 250Hz
+			{1044336221, -2088672443, 1044336221, 2087866987, -1015736075}, // high-pass 250Hz
+		}},
+		{"transducer", 4, {
+			{422074450, -844148901, 422074450, 2087866987, -1015736075}, // high-pass 250Hz, -7.9dB
+			{1044336221, -2088672443, 1044336221, 2087866987, -1015736075}, // high-pass 250Hz
+			{1137815081, -1950414207, 853587885, 1963636906, -904438443}, // low shelf 1kHz +9dB
+			{668329018, -380762057, 153412139, 979165123, -346402399}, // high shelf 6kHz -6dB
+		}},
+		{"loudness", 3, {
+			{568010445, -1136020890, 568010445, 2111708058, -1038552543}, // high-pass 150Hz, -5.4dB
+			{1090487320, -2089544284, 1002738653, 2090652275, -1018376158}, // low shelf 300Hz +8dB
+			{1509863487, -798208224, 334311492, 219977258, -192202190}, // high shelf 8kHz +5dB
+		}},
+	};
+
+	// x[n-1], x[n-2], y[n-1], y[n-2] in Q31 less the headroom, the output of one stage is the input of the next
+	struct State {
+		int32_t x1;
+		int32_t x2;
+		int32_t y1;
+		int32_t y2;
+	};
+
+	Preset const* preset;
+	State state[MAX_STAGES];
+
+	uint32_t samples;
+	uint32_t cycles;
+	uint32_t worst_cycles_per_sample;
+
+	// SMLAL, 32 x 32 into a 64 bit accumulator in one instruction. the portable version is the same arithmetic,
+	// so the host and the M4 give identical samples
+	static inline int64_t mac(int64_t acc, int32_t a, int32_t b){
+#if defined(__ARM_ARCH_7EM__)
+		uint32_t lo = static_cast<uint32_t>(acc);
+		uint32_t hi = static_cast<uint32_t>(static_cast<uint64_t>(acc) >> 32);
+		__asm__("smlal %0, %1, %2, %3" : "+r"(lo), "+r"(hi) : "r"(a), "r"(b));
+		return static_cast<int64_t>((static_cast<uint64_t>(hi) << 32) | lo);
+#else
+		return acc + static_cast<int64_t>(a) * b;
+#endif
+	}
+
+	static inline int32_t sat_q31(int64_t v){
+		return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : static_cast<int32_t>(v));
+	}
+
+	static inline int16_t sat_q15(int32_t v){
+#if defined(__ARM_ARCH_7EM__)
+		return static_cast<int16_t>(__SSAT(v, 16));
+#else
+		return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : static_cast<int16_t>(v));
+#endif
+	}
+
+public:
+	Equalizer() = default;
+
+	// starts flat, songs converted before the filter moved here already have the two high-passes baked in
+	void init(){
+		preset = &PRESETS[FLAT];
+		samples = 0;
+		cycles = 0;
+		worst_cycles_per_sample = 0;
+		reset();
+	}
+
+	// clears the history so the old coefficients do not ring through the new ones
+	void reset(){
+		for(uint8_t i = 0; i < MAX_STAGES; ++i){
+			state[i] = {0, 0, 0, 0};
+		}
+	}
+
+	// only from the main loop, process() runs there too
+	void set_preset(PRESET p){
+		if(p >= NUM_PRESETS)
+			return;
+		preset = &PRESETS[p];
+		reset();
+		printf("EQ %s\r\n", preset->name);
+	}
+
+	void next_preset(){
+		set_preset(static_cast<PRESET>((preset - PRESETS + 1) % NUM_PRESETS));
+	}
+
+	// the tables behind each preset, for the host harness's floating point reference
+	static char const* get_name(PRESET p){
+		return PRESETS[p].name;
+	}
+
+	static uint8_t get_num_stages(PRESET p){
+		return PRESETS[p].num_stages;
+	}
+
+	static BiquadCoeffs const& get_stage(PRESET p, uint8_t s){
+		return PRESETS[p].stages[s];
+	}
+
+	// filters 16 bit signed samples in place
+	void process(uint16_t* buf, uint32_t n){
+		uint8_t num_stages = preset->num_stages;
+		if(num_stages == 0)
+			return;
+
+		uint32_t start = DWT->CYCCNT;
+		for(uint32_t i = 0; i < n; ++i){
+			int32_t x = static_cast<int32_t>(static_cast<int16_t>(buf[i])) << (16 - HEADROOM_BITS);
+			for(uint8_t s = 0; s < num_stages; ++s){
+				BiquadCoeffs const& c = preset->stages[s];
+				State& st = state[s];
+				int64_t acc = static_cast<int64_t>(c.b0) * x;
+				acc = mac(acc, c.b1, st.x1);
+				acc = mac(acc, c.b2, st.x2);
+				acc = mac(acc, c.a1, st.y1);
+				acc = mac(acc, c.a2, st.y2);
+				int32_t y = sat_q31(acc >> (31 - POST_SHIFT));
+				st.x2 = st.x1;
+				st.x1 = x;
+				st.y2 = st.y1;
+				st.y1 = y;
+				x = y;
+			}
+			buf[i] = static_cast<uint16_t>(sat_q15(x >> (16 - HEADROOM_BITS)));
+		}
+
+		uint32_t elapsed = DWT->CYCCNT - start;
+		cycles += elapsed;
+		samples += n;
+		if(n && elapsed / n > worst_cycles_per_sample){
+			worst_cycles_per_sample = elapsed / n;
+		}
+	}
+
+	// average and worst cycles per sample since the last report, flagged when over budget
+	void report(){
+		if(samples == 0)
+			return;
+		uint32_t avg = cycles / samples;
+		printf("eq: %s %lu cycles/sample worst %lu%s\r\n", preset->name, avg, worst_cycles_per_sample,
+				worst_cycles_per_sample > BUDGET_CYCLES_PER_SAMPLE ? " over budget" : "");
+		samples = 0;
+		cycles = 0;
+		worst_cycles_per_sample = 0;
+	}
+};
@@ -0,0 +1,106 @@
+/*
+ * Fixed capacity single producer / single consumer queue for handing interrupt events to the main loop
+ */
+#pragma once
+
+#include "main.h"
+
+// every source that can wake the main loop from an interrupt
+enum EVENT_TYPE : uint8_t {
+	TOUCH_PENIRQ = 0x0,
+	TOUCH_DMA_DONE = 0x1,
+	AUDIO_DMA_DONE = 0x2,
+	CAMERA_TICK = 0x3,
+	UART_RX = 0x4,
+	UART_TX_DONE = 0x5,
+	AUDIO_DRQ = 0x6, // FPGA sample FIFO is half empty
+	AUX_BLOCK = 0x7, // half of the audio jack ADC buffer is ready
+	UART_ERROR = 0x8, // line error on the pixy UART, HAL has stopped the RX DMA
+	NUM_EVENT_TYPES = 0x9
+};
+
+// short names for the stats printout, in EVENT_TYPE order
+static constexpr char const* EVENT_NAMES[NUM_EVENT_TYPES] = {
+	"touch irq", "touch dma", "audio dma", "camera tick", "uart rx", "uart tx", "audio drq", "aux block",
+	"uart error"
+};
+
+struct Event {
+	EVENT_TYPE type;
+	uint32_t tick; // HAL tick when the interrupt fired
+};
+
+// the producer side must not preempt itself: every interrupt that pushes runs at the same NVIC priority,
+// so pushes from different ISRs are serialized and the queue only ever sees one producer at a time
+template <typename T, int CAPACITY>
+class EventQueue {
+private:
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of 2");
+
+	T items[CAPACITY];
+	volatile uint32_t head; // next slot to write, only the producer moves it
+	volatile uint32_t tail; // next slot to read, only the consumer moves it
+	volatile uint32_t dropped;
+
+public:
+	EventQueue() = default;
+
+	void init(){
+		head = 0;
+		tail = 0;
+		dropped = 0;
+	}
+
+	// called from interrupts, never blocks, returns false and counts the drop when full
+	bool push(T const& item){
+		uint32_t h = head;
+		if(h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) >= CAPACITY){
+			++dropped;
+			return false;
+		}
+		items[h & (CAPACITY - 1)] = item;
+		// the item has to be visible before the consumer can see the new head
+		__atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// called from the main loop only
+	bool pop(T* item){
+		uint32_t t = tail;
+		if(t == __atomic_load_n(&head, __ATOMIC_ACQUIRE)){
+			return false;
+		}
+		*item = items[t & (CAPACITY - 1)];
+		__atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	bool empty() const {
+		return head == tail;
+	}
+
+	uint32_t get_dropped() const {
+		return dropped;
+	}
+};
+
+// how often one interrupt source ran and its longest run, timed with the DWT cycle counter
+struct IsrStats {
+	volatile uint32_t count;
+	volatile uint32_t max_cycles;
+
+	void record(uint32_t start_cycles){
+		uint32_t cycles = DWT->CYCCNT - start_cycles;
+		++count;
+		if(cycles > max_cycles){
+			max_cycles = cycles;
+		}
+	}
+
+	// runs and longest run since the last call, from the main loop. the counters are swapped out atomically so
+	// an interrupt landing in between is counted in the next window
+	void take(uint32_t* runs, uint32_t* worst_cycles){
+		*runs = __atomic_exchange_n(&count, 0, __ATOMIC_RELAXED);
+		*worst_cycles = __atomic_exchange_n(&max_cycles, 0, __ATOMIC_RELAXED);
+	}
+};
@@ -1,375 +1,145 @@
+#pragma once
 
-constexpr int FONT_WIDTH = 8;
-constexpr int FONT_HEIGHT = 12;
-constexpr int FONT_SPACING = 2;
-constexpr int FONT_SIZE = 2;
+#include <stdint.h>
 
 constexpr uint8_t FONT_R = 0;
 constexpr uint8_t FONT_G = 0;
 constexpr uint8_t FONT_B = 0;
 
-uint8_t font [312]{
-	// A
-	0b00011000,
-	0b00100100,
-	0b00100100,
-	0b00100100,
-	0b01000010,
-	0b01000010,
-	0b01111110,
-	0b01111110,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-
-	// B
-	0b11111100,
-	0b10000110,
-	0b10000011,
-	0b10000001,
-	0b10000001,
-	0b10000011,
-	0b11111110,
-	0b10000011,
-	0b10000001,
-	0b10000011,
-	0b10000110,
-	0b11111100,
-
-	// C
-	0b00111100,
-	0b01100110,
-	0b11000011,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b11000011,
-	0b01100110,
-	0b00111100,
-
-	// D
-	0b11111100,
-	0b10000110,
-	0b10000011,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000011,
-	0b10000110,
-	0b11111100,
-
-	// E
-	0b11111111,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b11111111,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b11111111,
-
-	// F
-	0b11111111,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b11111111,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-
-	// G
-	0b00111100,
-	0b01100110,
-	0b11000011,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10001111,
-	0b10001111,
-	0b11000011,
-	0b01100110,
-	0b00111100,
-
-	// H
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b11111111,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-
-	// I
-	0b11111111,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b11111111,
-
-	// J
-	0b11111111,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b00000110,
-	0b10000110,
-	0b11011100,
-	0b01111000,
-
-	// K
-	0b10000011,
-	0b10000110,
-	0b10001100,
-	0b10011000,
-	0b10110000,
-	0b11100000,
-	0b11100000,
-	0b10110000,
-	0b10011000,
-	0b10001100,
-	0b10000110,
-	0b10000011,
-
-	// L
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b11111111,
-
-	// M
-	0b10000001,
-	0b11000011,
-	0b11100111,
-	0b10111101,
-	0b10011001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-
-	// N
-	0b11000001,
-	0b11000001,
-	0b11100001,
-	0b10110001,
-	0b10110001,
-	0b10111001,
-	0b10011001,
-	0b10011001,
-	0b10001101,
-	0b10001101,
-	0b10000111,
-	0b10000011,
-
-	// O
-	0b00111100,
-	0b01100110,
-	0b11000011,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b11000011,
-	0b01100110,
-	0b00111100,
-
-	// P
-	0b11111100,
-	0b10000110,
-	0b10000001,
-	0b10000001,
-	0b10000011,
-	0b10000110,
-	0b11111100,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-	0b10000000,
-
-	// Q
-	0b00111100,
-	0b01100110,
-	0b11000011,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b11001011,
-	0b01100110,
-	0b00111101,
-
-	// R
-	0b11111100,
-	0b10000110,
-	0b10000001,
-	0b10000001,
-	0b10000011,
-	0b10000110,
-	0b11111100,
-	0b11100000,
-	0b10110000,
-	0b10011000,
-	0b10001100,
-	0b10000110,
-
-	// S
-	0b00111100,
-	0b01100110,
-	0b11000011,
-	0b10000000,
-	0b1100000,
-	0b01111100,
-	0b00000110,
-	0b00000011,
-	0b00000001,
-	0b00000011,
-	0b11000110,
-	0b01111100,
-
-	// T
-	0b11111111,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-
-	// U
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b11000011,
-	0b01100110,
-	0b00111100,
+/*
+ * Proportional 1 bit fonts generated by fonts/gen_font.py
+ *
+ * Each glyph bitmap is w x h pixels, row major, run length encoded: every byte holds the pixel value in
+ * bit 7 and the run length - 1 in bits 6..0. The atlases, glyph tables and kerning pairs are all
+ * constexpr so they stay in flash.
+ */
+
+struct Glyph {
+	uint16_t offset; // first RLE byte of the bitmap
+	uint8_t w;
+	uint8_t h;
+	int8_t x_off; // from the pen position to the left edge of the bitmap
+	int8_t y_off; // from the top of the line to the top edge of the bitmap
+	uint8_t advance;
+};
 
-	// V
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b11000011,
-	0b01000010,
-	0b01000010,
-	0b01100110,
-	0b00100100,
-	0b00100100,
-	0b00111100,
-	0b00011000,
-	0b00011000,
+// pixels to add to the advance of left when it is followed by right, sorted by (left, right)
+struct Kern {
+	uint8_t left;
+	uint8_t right;
+	int8_t adjust;
+};
 
-	// W
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10000001,
-	0b10011001,
-	0b10111101,
-	0b11100111,
-	0b11000011,
+static constexpr int FONT_INDEX_SIZE = 128;
+static constexpr uint8_t FONT_NO_GLYPH = 0xFF;
 
-	// X
-	0b11000011,
-	0b11000011,
-	0b00100100,
-	0b00100100,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00100100,
-	0b00100100,
-	0b11000011,
-	0b11000011,
+// ASCII -> position in the glyph table
+struct GlyphIndex {
+	uint8_t glyph[FONT_INDEX_SIZE];
+};
 
-	// Y
-	0b11000011,
-	0b11000011,
-	0b00100100,
-	0b00100100,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
-	0b00011000,
+// builds the glyph index from the atlas charset at compile time
+constexpr GlyphIndex make_glyph_index(char const* charset){
+	GlyphIndex index{};
+	for(int c = 0; c < FONT_INDEX_SIZE; ++c){
+		index.glyph[c] = FONT_NO_GLYPH;
+	}
+	for(int i = 0; charset[i]; ++i){
+		index.glyph[static_cast<uint8_t>(charset[i])] = i;
+	}
+	return index;
+}
+
+struct Font {
+	uint8_t const* rle;
+	Glyph const* glyphs;
+	Kern const* kerns;
+	uint16_t num_kerns;
+	GlyphIndex const* index;
+	uint8_t line_h;
+};
 
-	// Z
-	0b11111111,
-	0b00000011,
-	0b00000100,
-	0b00000100,
-	0b00001000,
-	0b00001000,
-	0b00010000,
-	0b00010000,
-	0b00100000,
-	0b00100000,
-	0b11000000,
-	0b11111111
+#include "font_data.hpp"
+
+// characters missing from the atlas are drawn as '?'
+inline Glyph const* font_find(Font const& font, char c){
+	uint8_t ch = static_cast<uint8_t>(c);
+	uint8_t i = (ch < FONT_INDEX_SIZE) ? font.index->glyph[ch] : FONT_NO_GLYPH;
+	if(i == FONT_NO_GLYPH){
+		i = font.index->glyph[static_cast<uint8_t>('?')];
+	}
+	return &font.glyphs[i];
+}
+
+inline int font_kern(Font const& font, char left, char right){
+	int lo = 0;
+	int hi = font.num_kerns - 1;
+	uint16_t key = (static_cast<uint8_t>(left) << 8) | static_cast<uint8_t>(right);
+	while(lo <= hi){
+		int mid = (lo + hi) / 2;
+		uint16_t mid_key = (font.kerns[mid].left << 8) | font.kerns[mid].right;
+		if(mid_key == key){
+			return font.kerns[mid].adjust;
+		}else if(mid_key < key){
+			lo = mid + 1;
+		}else{
+			hi = mid - 1;
+		}
+	}
+	return 0;
+}
+
+// how far the pen moves after c, next is the following character or '\0'
+inline int font_advance(Font const& font, char c, char next){
+	int advance = font_find(font, c)->advance;
+	if(next){
+		advance += font_kern(font, c, next);
+	}
+	return advance;
+}
+
+inline int font_text_width(Font const& font, char const* str){
+	int width = 0;
+	for(int i = 0; str[i]; ++i){
+		width += font_advance(font, str[i], str[i + 1]);
+	}
+	return width;
+}
+
+// decodes a glyph's RLE bitmap one pixel at a time
+class GlyphReader {
+private:
+	uint8_t const* rle;
+	int run;
+	bool on;
+
+public:
+	GlyphReader(Font const& font, Glyph const* glyph) : rle(&font.rle[glyph->offset]), run(0), on(false) {}
+
+	bool next(){
+		if(run == 0){
+			on = (*rle & 0x80) == 0x80;
+			run = (*rle & 0x7F) + 1;
+			++rle;
+		}
+		--run;
+		return on;
+	}
 };
+
+// calls plot(x, y) for every set pixel of str, (x, y) is the top left of the line
+template <typename Plot>
+void font_rasterize(Font const& font, int x, int y, char const* str, Plot plot){
+	for(int i = 0; str[i]; ++i){
+		Glyph const* glyph = font_find(font, str[i]);
+		GlyphReader reader(font, glyph);
+		for(int row = 0; row < glyph->h; ++row){
+			for(int col = 0; col < glyph->w; ++col){
+				if(reader.next()){
+					plot(x + glyph->x_off + col, y + glyph->y_off + row);
+				}
+			}
+		}
+		x += font_advance(font, str[i], str[i + 1]);
+	}
+}
@@ -0,0 +1,837 @@
+/*
+ * Generated by fonts/gen_font.py, do not edit by hand
+ */
+#pragma once
+
+constexpr char FONT_CHARSET[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+constexpr GlyphIndex FONT_GLYPH_INDEX = make_glyph_index(FONT_CHARSET);
+
+// DejaVuSans-Bold.ttf 20px, 3626 bytes of glyph data
+constexpr uint8_t label_rle[] = {
+	0x02, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82,
+	0x05, 0x82, 0x05, 0x82, 0x0E, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x02, 0x01, 0x81, 0x01,
+	0x82, 0x02, 0x81, 0x01, 0x82, 0x02, 0x81, 0x01, 0x82, 0x02, 0x81, 0x01, 0x82, 0x02, 0x81, 0x01,
+	0x82, 0x64, 0x06, 0x81, 0x01, 0x82, 0x08, 0x82, 0x01, 0x81, 0x09, 0x81, 0x02, 0x81, 0x09, 0x81,
+	0x02, 0x81, 0x05, 0x8C, 0x03, 0x8C, 0x06, 0x81, 0x02, 0x81, 0x09, 0x81, 0x02, 0x81, 0x09, 0x81,
+	0x01, 0x82, 0x05, 0x8C, 0x03, 0x8C, 0x06, 0x81, 0x02, 0x81, 0x09, 0x81, 0x01, 0x82, 0x08, 0x82,
+	0x01, 0x81, 0x09, 0x81, 0x02, 0x81, 0x06, 0x05, 0x81, 0x0B, 0x81, 0x09, 0x85, 0x05, 0x89, 0x03,
+	0x82, 0x00, 0x81, 0x01, 0x81, 0x03, 0x82, 0x00, 0x81, 0x07, 0x82, 0x00, 0x81, 0x07, 0x87, 0x06,
+	0x88, 0x05, 0x87, 0x07, 0x85, 0x07, 0x81, 0x00, 0x83, 0x02, 0x80, 0x02, 0x81, 0x00, 0x82, 0x03,
+	0x89, 0x04, 0x86, 0x09, 0x81, 0x0B, 0x81, 0x0B, 0x81, 0x05, 0x01, 0x84, 0x05, 0x81, 0x05, 0x86,
+	0x04, 0x81, 0x05, 0x82, 0x01, 0x81, 0x03, 0x81, 0x06, 0x81, 0x02, 0x81, 0x02, 0x82, 0x06, 0x81,
+	0x02, 0x81, 0x02, 0x81, 0x07, 0x82, 0x01, 0x81, 0x01, 0x81, 0x08, 0x86, 0x01, 0x81, 0x09, 0x84,
+	0x01, 0x81, 0x01, 0x84, 0x09, 0x82, 0x00, 0x86, 0x08, 0x81, 0x01, 0x82, 0x00, 0x82, 0x07, 0x81,
+	0x02, 0x81, 0x02, 0x81, 0x07, 0x81, 0x02, 0x81, 0x02, 0x81, 0x06, 0x81, 0x03, 0x82, 0x00, 0x82,
+	0x05, 0x81, 0x04, 0x86, 0x05, 0x81, 0x05, 0x84, 0x01, 0x05, 0x83, 0x0A, 0x87, 0x08, 0x82, 0x03,
+	0x80, 0x07, 0x83, 0x0D, 0x82, 0x0D, 0x83, 0x0B, 0x85, 0x03, 0x82, 0x02, 0x87, 0x02, 0x82, 0x02,
+	0x82, 0x01, 0x83, 0x00, 0x83, 0x01, 0x83, 0x01, 0x87, 0x02, 0x83, 0x02, 0x86, 0x02, 0x83, 0x03,
+	0x84, 0x04, 0x83, 0x02, 0x84, 0x05, 0x8B, 0x05, 0x85, 0x01, 0x83, 0x00, 0x01, 0x81, 0x03, 0x81,
+	0x03, 0x81, 0x03, 0x81, 0x03, 0x81, 0x3D, 0x03, 0x82, 0x05, 0x82, 0x04, 0x82, 0x05, 0x82, 0x05,
+	0x82, 0x04, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05,
+	0x82, 0x05, 0x83, 0x05, 0x82, 0x05, 0x82, 0x06, 0x82, 0x05, 0x82, 0x01, 0x01, 0x82, 0x05, 0x82,
+	0x06, 0x82, 0x05, 0x82, 0x05, 0x83, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82,
+	0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x04, 0x83, 0x04, 0x82, 0x05, 0x82, 0x04, 0x82, 0x05, 0x82,
+	0x03, 0x03, 0x81, 0x08, 0x81, 0x05, 0x80, 0x01, 0x81, 0x01, 0x81, 0x01, 0x87, 0x04, 0x83, 0x04,
+	0x87, 0x02, 0x80, 0x01, 0x81, 0x01, 0x81, 0x04, 0x81, 0x08, 0x81, 0x46, 0x06, 0x82, 0x0D, 0x82,
+	0x0D, 0x82, 0x0D, 0x82, 0x0D, 0x82, 0x08, 0x8C, 0x03, 0x8C, 0x08, 0x82, 0x0D, 0x82, 0x0D, 0x82,
+	0x0D, 0x82, 0x0D, 0x82, 0x06, 0x01, 0x83, 0x03, 0x83, 0x03, 0x83, 0x03, 0x82, 0x04, 0x82, 0x03,
+	0x82, 0x04, 0x81, 0x04, 0x00, 0x85, 0x01, 0x85, 0x01, 0x85, 0x20, 0x01, 0x83, 0x03, 0x83, 0x03,
+	0x83, 0x03, 0x83, 0x01, 0x04, 0x81, 0x05, 0x81, 0x04, 0x82, 0x04, 0x81, 0x05, 0x81, 0x04, 0x82,
+	0x04, 0x81, 0x05, 0x81, 0x04, 0x82, 0x04, 0x81, 0x05, 0x81, 0x04, 0x82, 0x04, 0x81, 0x05, 0x81,
+	0x04, 0x82, 0x04, 0x81, 0x05, 0x03, 0x84, 0x07, 0x87, 0x04, 0x83, 0x01, 0x83, 0x03, 0x82, 0x03,
+	0x82, 0x02, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03,
+	0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x02, 0x82, 0x03,
+	0x82, 0x03, 0x83, 0x01, 0x83, 0x04, 0x87, 0x06, 0x84, 0x04, 0x03, 0x84, 0x06, 0x86, 0x06, 0x81,
+	0x01, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82,
+	0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x06, 0x8A, 0x02, 0x8A, 0x00, 0x02, 0x85, 0x06, 0x88, 0x04,
+	0x81, 0x02, 0x84, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08,
+	0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x09, 0x89, 0x03, 0x89, 0x01, 0x02, 0x86, 0x05, 0x88,
+	0x04, 0x80, 0x03, 0x84, 0x09, 0x83, 0x09, 0x83, 0x08, 0x83, 0x06, 0x85, 0x07, 0x86, 0x09, 0x84,
+	0x09, 0x83, 0x0A, 0x82, 0x09, 0x83, 0x02, 0x81, 0x03, 0x84, 0x02, 0x89, 0x05, 0x85, 0x04, 0x05,
+	0x84, 0x08, 0x84, 0x07, 0x85, 0x06, 0x86, 0x06, 0x86, 0x05, 0x82, 0x00, 0x83, 0x04, 0x82, 0x01,
+	0x83, 0x04, 0x82, 0x01, 0x83, 0x03, 0x82, 0x02, 0x83, 0x03, 0x82, 0x02, 0x83, 0x03, 0x8B, 0x01,
+	0x8B, 0x07, 0x83, 0x09, 0x83, 0x09, 0x83, 0x02, 0x01, 0x88, 0x04, 0x88, 0x04, 0x82, 0x0A, 0x82,
+	0x0A, 0x82, 0x0A, 0x87, 0x05, 0x88, 0x04, 0x80, 0x03, 0x84, 0x09, 0x83, 0x0A, 0x82, 0x0A, 0x82,
+	0x09, 0x83, 0x03, 0x80, 0x03, 0x84, 0x03, 0x88, 0x05, 0x85, 0x04, 0x04, 0x85, 0x06, 0x87, 0x04,
+	0x83, 0x03, 0x80, 0x03, 0x83, 0x09, 0x82, 0x09, 0x83, 0x00, 0x83, 0x04, 0x8A, 0x02, 0x84, 0x01,
+	0x83, 0x02, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03,
+	0x83, 0x02, 0x83, 0x01, 0x83, 0x04, 0x87, 0x07, 0x84, 0x03, 0x00, 0x8A, 0x02, 0x8A, 0x09, 0x83,
+	0x09, 0x83, 0x08, 0x83, 0x09, 0x83, 0x08, 0x83, 0x09, 0x83, 0x09, 0x83, 0x08, 0x83, 0x09, 0x83,
+	0x08, 0x83, 0x09, 0x83, 0x09, 0x82, 0x09, 0x83, 0x06, 0x03, 0x85, 0x05, 0x89, 0x03, 0x83, 0x01,
+	0x83, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x83, 0x01, 0x83, 0x04, 0x87, 0x05,
+	0x87, 0x04, 0x83, 0x01, 0x83, 0x02, 0x83, 0x03, 0x82, 0x02, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03,
+	0x83, 0x02, 0x83, 0x01, 0x83, 0x03, 0x89, 0x05, 0x85, 0x03, 0x03, 0x84, 0x07, 0x87, 0x04, 0x82,
+	0x02, 0x82, 0x03, 0x83, 0x02, 0x83, 0x02, 0x83, 0x03, 0x82, 0x02, 0x83, 0x03, 0x83, 0x01, 0x83,
+	0x02, 0x84, 0x02, 0x82, 0x02, 0x84, 0x02, 0x8A, 0x04, 0x83, 0x00, 0x82, 0x0A, 0x82, 0x09, 0x83,
+	0x03, 0x80, 0x03, 0x83, 0x04, 0x87, 0x06, 0x85, 0x04, 0x01, 0x83, 0x03, 0x83, 0x03, 0x83, 0x03,
+	0x83, 0x1B, 0x83, 0x03, 0x83, 0x03, 0x83, 0x03, 0x83, 0x01, 0x01, 0x83, 0x03, 0x83, 0x03, 0x83,
+	0x03, 0x83, 0x1B, 0x83, 0x03, 0x83, 0x03, 0x83, 0x03, 0x83, 0x03, 0x82, 0x04, 0x81, 0x04, 0x82,
+	0x03, 0x0C, 0x81, 0x0B, 0x84, 0x09, 0x85, 0x07, 0x85, 0x07, 0x85, 0x0A, 0x83, 0x0C, 0x85, 0x0D,
+	0x85, 0x0D, 0x85, 0x0C, 0x84, 0x0E, 0x81, 0x12, 0x01, 0x8C, 0x03, 0x8C, 0x25, 0x8C, 0x03, 0x8C,
+	0x34, 0x01, 0x81, 0x0E, 0x83, 0x0D, 0x85, 0x0D, 0x85, 0x0D, 0x84, 0x0D, 0x83, 0x0A, 0x84, 0x08,
+	0x85, 0x07, 0x85, 0x09, 0x83, 0x0C, 0x81, 0x1D, 0x02, 0x84, 0x04, 0x88, 0x02, 0x81, 0x02, 0x83,
+	0x08, 0x82, 0x07, 0x83, 0x07, 0x83, 0x06, 0x83, 0x06, 0x83, 0x07, 0x82, 0x07, 0x83, 0x13, 0x83,
+	0x07, 0x83, 0x07, 0x83, 0x07, 0x83, 0x04, 0x06, 0x85, 0x0B, 0x89, 0x08, 0x83, 0x04, 0x82, 0x06,
+	0x82, 0x08, 0x81, 0x04, 0x82, 0x02, 0x82, 0x00, 0x81, 0x01, 0x81, 0x03, 0x81, 0x02, 0x86, 0x01,
+	0x81, 0x03, 0x81, 0x01, 0x82, 0x01, 0x82, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x03, 0x81, 0x02,
+	0x81, 0x01, 0x81, 0x02, 0x81, 0x03, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x03, 0x81, 0x02,
+	0x80, 0x02, 0x81, 0x02, 0x81, 0x03, 0x81, 0x01, 0x81, 0x03, 0x81, 0x01, 0x82, 0x01, 0x82, 0x00,
+	0x82, 0x03, 0x81, 0x02, 0x89, 0x04, 0x82, 0x02, 0x82, 0x00, 0x82, 0x07, 0x82, 0x07, 0x80, 0x08,
+	0x82, 0x04, 0x82, 0x09, 0x89, 0x0B, 0x85, 0x06, 0x04, 0x84, 0x0A, 0x85, 0x09, 0x85, 0x08, 0x86,
+	0x08, 0x87, 0x07, 0x82, 0x00, 0x83, 0x06, 0x83, 0x01, 0x82, 0x06, 0x83, 0x01, 0x83, 0x04, 0x83,
+	0x02, 0x83, 0x04, 0x83, 0x03, 0x82, 0x04, 0x8B, 0x02, 0x8C, 0x02, 0x83, 0x05, 0x82, 0x02, 0x82,
+	0x06, 0x83, 0x00, 0x83, 0x06, 0x83, 0x00, 0x01, 0x88, 0x05, 0x89, 0x04, 0x83, 0x02, 0x83, 0x03,
+	0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x89, 0x04, 0x89, 0x04,
+	0x83, 0x02, 0x83, 0x03, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02,
+	0x83, 0x02, 0x83, 0x03, 0x8A, 0x03, 0x88, 0x03, 0x05, 0x85, 0x06, 0x88, 0x04, 0x83, 0x04, 0x80,
+	0x03, 0x83, 0x0A, 0x82, 0x0A, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x0B, 0x82,
+	0x0B, 0x83, 0x0B, 0x83, 0x04, 0x80, 0x05, 0x88, 0x07, 0x85, 0x02, 0x01, 0x88, 0x07, 0x8A, 0x05,
+	0x83, 0x02, 0x84, 0x04, 0x83, 0x03, 0x84, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x05, 0x82, 0x03, 0x83, 0x05, 0x83, 0x02, 0x83, 0x05, 0x82, 0x03, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x04, 0x83, 0x03, 0x83, 0x03, 0x84, 0x03, 0x83, 0x02, 0x84, 0x04, 0x8A, 0x05, 0x88, 0x05,
+	0x01, 0x89, 0x03, 0x89, 0x03, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x89, 0x03, 0x89,
+	0x03, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x89, 0x03, 0x89, 0x01, 0x01,
+	0x89, 0x03, 0x89, 0x03, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x89, 0x03, 0x89, 0x03,
+	0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x07, 0x05, 0x86,
+	0x06, 0x89, 0x04, 0x83, 0x05, 0x80, 0x03, 0x83, 0x0B, 0x82, 0x0B, 0x83, 0x0B, 0x83, 0x0B, 0x83,
+	0x03, 0x85, 0x01, 0x83, 0x03, 0x85, 0x01, 0x83, 0x05, 0x83, 0x02, 0x82, 0x05, 0x83, 0x02, 0x83,
+	0x04, 0x83, 0x03, 0x83, 0x03, 0x83, 0x04, 0x8A, 0x06, 0x86, 0x02, 0x01, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x04, 0x83, 0x03, 0x8C, 0x03, 0x8C, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03, 0x83, 0x04, 0x83, 0x03,
+	0x83, 0x04, 0x83, 0x01, 0x01, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83,
+	0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83,
+	0x02, 0x83, 0x00, 0x03, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04,
+	0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04,
+	0x83, 0x04, 0x82, 0x04, 0x83, 0x02, 0x84, 0x03, 0x83, 0x03, 0x01, 0x83, 0x04, 0x83, 0x03, 0x83,
+	0x03, 0x83, 0x04, 0x83, 0x02, 0x83, 0x05, 0x83, 0x01, 0x83, 0x06, 0x83, 0x00, 0x83, 0x07, 0x87,
+	0x08, 0x86, 0x09, 0x86, 0x09, 0x87, 0x08, 0x88, 0x07, 0x83, 0x00, 0x84, 0x06, 0x83, 0x01, 0x84,
+	0x05, 0x83, 0x02, 0x84, 0x04, 0x83, 0x03, 0x84, 0x03, 0x83, 0x04, 0x84, 0x00, 0x01, 0x83, 0x08,
+	0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08,
+	0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x83, 0x08, 0x89, 0x02, 0x89, 0x00, 0x01, 0x84, 0x05, 0x84,
+	0x03, 0x84, 0x05, 0x84, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x02, 0x86,
+	0x03, 0x82, 0x00, 0x82, 0x01, 0x86, 0x03, 0x82, 0x00, 0x82, 0x01, 0x81, 0x00, 0x83, 0x03, 0x82,
+	0x01, 0x85, 0x00, 0x83, 0x03, 0x82, 0x01, 0x85, 0x00, 0x83, 0x03, 0x82, 0x02, 0x83, 0x01, 0x83,
+	0x03, 0x82, 0x02, 0x83, 0x01, 0x83, 0x03, 0x82, 0x03, 0x81, 0x02, 0x83, 0x03, 0x82, 0x08, 0x83,
+	0x03, 0x82, 0x08, 0x83, 0x03, 0x82, 0x08, 0x83, 0x01, 0x01, 0x83, 0x04, 0x83, 0x03, 0x84, 0x03,
+	0x83, 0x03, 0x84, 0x03, 0x83, 0x03, 0x85, 0x02, 0x83, 0x03, 0x85, 0x02, 0x83, 0x03, 0x86, 0x01,
+	0x83, 0x03, 0x82, 0x00, 0x82, 0x01, 0x83, 0x03, 0x82, 0x01, 0x82, 0x00, 0x83, 0x03, 0x82, 0x01,
+	0x82, 0x00, 0x83, 0x03, 0x82, 0x02, 0x86, 0x03, 0x82, 0x02, 0x86, 0x03, 0x82, 0x03, 0x85, 0x03,
+	0x82, 0x03, 0x85, 0x03, 0x82, 0x04, 0x84, 0x03, 0x82, 0x04, 0x84, 0x01, 0x04, 0x86, 0x08, 0x88,
+	0x06, 0x83, 0x02, 0x83, 0x04, 0x83, 0x04, 0x83, 0x02, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83,
+	0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83,
+	0x01, 0x83, 0x06, 0x83, 0x02, 0x83, 0x04, 0x83, 0x04, 0x83, 0x02, 0x83, 0x06, 0x88, 0x08, 0x86,
+	0x04, 0x01, 0x88, 0x05, 0x8A, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03,
+	0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x02, 0x83, 0x03, 0x8A, 0x03,
+	0x88, 0x05, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x0A, 0x83, 0x08, 0x04, 0x86, 0x08, 0x88,
+	0x06, 0x83, 0x02, 0x83, 0x04, 0x83, 0x04, 0x83, 0x02, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83,
+	0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83, 0x01, 0x83, 0x06, 0x83,
+	0x01, 0x83, 0x06, 0x83, 0x02, 0x83, 0x04, 0x83, 0x04, 0x83, 0x02, 0x83, 0x06, 0x88, 0x08, 0x86,
+	0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x82, 0x02, 0x01, 0x88, 0x05, 0x89, 0x04, 0x83, 0x02, 0x83, 0x03,
+	0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x82, 0x04,
+	0x88, 0x05, 0x88, 0x05, 0x83, 0x01, 0x83, 0x04, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x03,
+	0x83, 0x03, 0x83, 0x02, 0x83, 0x03, 0x83, 0x02, 0x83, 0x04, 0x83, 0x03, 0x87, 0x04, 0x88, 0x03,
+	0x83, 0x03, 0x81, 0x03, 0x82, 0x05, 0x80, 0x02, 0x83, 0x0A, 0x83, 0x09, 0x87, 0x06, 0x88, 0x05,
+	0x88, 0x08, 0x84, 0x09, 0x83, 0x09, 0x83, 0x02, 0x81, 0x04, 0x83, 0x02, 0x89, 0x04, 0x86, 0x03,
+	0x9B, 0x04, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09,
+	0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x04, 0x01, 0x83, 0x04, 0x82,
+	0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82,
+	0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82,
+	0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x04, 0x82, 0x03, 0x83, 0x03, 0x83, 0x04, 0x83, 0x02, 0x83,
+	0x04, 0x89, 0x07, 0x85, 0x04, 0x83, 0x06, 0x83, 0x01, 0x82, 0x06, 0x83, 0x01, 0x83, 0x05, 0x82,
+	0x02, 0x83, 0x04, 0x83, 0x03, 0x82, 0x04, 0x83, 0x03, 0x83, 0x03, 0x82, 0x04, 0x83, 0x02, 0x83,
+	0x05, 0x82, 0x02, 0x83, 0x05, 0x83, 0x01, 0x82, 0x07, 0x82, 0x00, 0x83, 0x07, 0x87, 0x07, 0x86,
+	0x09, 0x85, 0x09, 0x85, 0x09, 0x84, 0x05, 0x00, 0x82, 0x04, 0x83, 0x04, 0x82, 0x01, 0x83, 0x03,
+	0x83, 0x04, 0x82, 0x01, 0x83, 0x03, 0x83, 0x03, 0x83, 0x01, 0x83, 0x02, 0x85, 0x02, 0x83, 0x02,
+	0x82, 0x02, 0x85, 0x02, 0x82, 0x03, 0x82, 0x02, 0x85, 0x02, 0x82, 0x03, 0x83, 0x01, 0x81, 0x01,
+	0x81, 0x01, 0x83, 0x03, 0x83, 0x00, 0x82, 0x01, 0x82, 0x00, 0x83, 0x04, 0x82, 0x00, 0x82, 0x01,
+	0x82, 0x00, 0x82, 0x05, 0x82, 0x00, 0x82, 0x01, 0x82, 0x00, 0x82, 0x05, 0x85, 0x03, 0x85, 0x05,
+	0x85, 0x03, 0x85, 0x05, 0x85, 0x03, 0x85, 0x06, 0x84, 0x03, 0x84, 0x07, 0x84, 0x04, 0x83, 0x03,
+	0x00, 0x83, 0x05, 0x82, 0x03, 0x82, 0x04, 0x83, 0x03, 0x83, 0x02, 0x83, 0x05, 0x83, 0x01, 0x83,
+	0x06, 0x87, 0x07, 0x86, 0x09, 0x85, 0x09, 0x84, 0x0A, 0x85, 0x08, 0x86, 0x07, 0x83, 0x00, 0x83,
+	0x06, 0x83, 0x01, 0x83, 0x04, 0x83, 0x02, 0x83, 0x03, 0x83, 0x04, 0x83, 0x02, 0x83, 0x05, 0x83,
+	0x00, 0x00, 0x83, 0x05, 0x83, 0x02, 0x83, 0x04, 0x83, 0x02, 0x83, 0x03, 0x83, 0x04, 0x83, 0x01,
+	0x83, 0x06, 0x83, 0x00, 0x83, 0x06, 0x87, 0x08, 0x86, 0x09, 0x84, 0x0A, 0x83, 0x0B, 0x83, 0x0B,
+	0x83, 0x0B, 0x83, 0x0B, 0x83, 0x0B, 0x83, 0x0B, 0x83, 0x05, 0x00, 0x8B, 0x02, 0x8B, 0x09, 0x84,
+	0x09, 0x84, 0x08, 0x84, 0x08, 0x84, 0x08, 0x84, 0x09, 0x84, 0x08, 0x84, 0x08, 0x84, 0x08, 0x84,
+	0x09, 0x84, 0x08, 0x84, 0x09, 0x8C, 0x01, 0x8C, 0x00, 0x01, 0x85, 0x02, 0x85, 0x02, 0x82, 0x05,
+	0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05,
+	0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x85, 0x02, 0x85, 0x00, 0x81, 0x05,
+	0x82, 0x05, 0x81, 0x05, 0x81, 0x05, 0x82, 0x05, 0x81, 0x05, 0x81, 0x05, 0x82, 0x05, 0x81, 0x05,
+	0x81, 0x05, 0x82, 0x05, 0x81, 0x05, 0x81, 0x05, 0x82, 0x05, 0x81, 0x05, 0x81, 0x00, 0x00, 0x85,
+	0x02, 0x85, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82,
+	0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x05, 0x82, 0x02, 0x85,
+	0x02, 0x85, 0x01, 0x06, 0x82, 0x0C, 0x84, 0x0A, 0x82, 0x00, 0x82, 0x08, 0x82, 0x02, 0x82, 0x06,
+	0x81, 0x06, 0x81, 0x7F, 0x2C, 0x1D, 0x93, 0x00, 0x82, 0x07, 0x82, 0x07, 0x81, 0x08, 0x81, 0x7B,
+	0x01, 0x86, 0x06, 0x88, 0x0A, 0x83, 0x09, 0x83, 0x04, 0x88, 0x03, 0x89, 0x02, 0x83, 0x02, 0x83,
+	0x02, 0x82, 0x03, 0x83, 0x02, 0x83, 0x01, 0x84, 0x02, 0x8A, 0x04, 0x83, 0x00, 0x83, 0x01, 0x01,
+	0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x01, 0x83, 0x04, 0x89, 0x03, 0x83, 0x02,
+	0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x82, 0x04, 0x82, 0x02, 0x82, 0x04, 0x82, 0x02, 0x82, 0x04,
+	0x82, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x89, 0x03, 0x82, 0x01, 0x83, 0x02,
+	0x03, 0x84, 0x05, 0x87, 0x02, 0x83, 0x06, 0x83, 0x07, 0x83, 0x07, 0x83, 0x07, 0x83, 0x07, 0x83,
+	0x08, 0x83, 0x08, 0x87, 0x04, 0x84, 0x02, 0x08, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x04,
+	0x82, 0x01, 0x83, 0x02, 0x8A, 0x02, 0x83, 0x01, 0x84, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03,
+	0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x02, 0x83, 0x01,
+	0x84, 0x02, 0x8A, 0x04, 0x82, 0x01, 0x83, 0x00, 0x03, 0x85, 0x05, 0x88, 0x04, 0x82, 0x02, 0x83,
+	0x02, 0x83, 0x03, 0x82, 0x02, 0x8B, 0x01, 0x8B, 0x01, 0x83, 0x09, 0x83, 0x0A, 0x83, 0x04, 0x80,
+	0x03, 0x89, 0x05, 0x85, 0x03, 0x03, 0x84, 0x02, 0x85, 0x01, 0x83, 0x04, 0x83, 0x02, 0x91, 0x01,
+	0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04, 0x83, 0x04,
+	0x83, 0x02, 0x03, 0x82, 0x01, 0x83, 0x02, 0x8A, 0x02, 0x83, 0x01, 0x84, 0x01, 0x83, 0x03, 0x83,
+	0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83,
+	0x02, 0x83, 0x01, 0x84, 0x02, 0x8A, 0x04, 0x82, 0x01, 0x83, 0x09, 0x82, 0x03, 0x80, 0x04, 0x83,
+	0x03, 0x88, 0x06, 0x84, 0x04, 0x01, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x01,
+	0x83, 0x04, 0x89, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02,
+	0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02,
+	0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x00, 0x01, 0x82, 0x03, 0x82, 0x03, 0x82, 0x0A, 0x82,
+	0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82,
+	0x03, 0x82, 0x03, 0x82, 0x01, 0x02, 0x82, 0x04, 0x82, 0x04, 0x82, 0x0C, 0x82, 0x04, 0x82, 0x04,
+	0x82, 0x04, 0x82, 0x04, 0x82, 0x04, 0x82, 0x04, 0x82, 0x04, 0x82, 0x04, 0x82, 0x04, 0x82, 0x04,
+	0x82, 0x04, 0x82, 0x03, 0x83, 0x01, 0x84, 0x02, 0x83, 0x03, 0x01, 0x82, 0x0A, 0x82, 0x0A, 0x82,
+	0x0A, 0x82, 0x0A, 0x82, 0x03, 0x83, 0x02, 0x82, 0x02, 0x83, 0x03, 0x82, 0x01, 0x83, 0x04, 0x82,
+	0x00, 0x83, 0x05, 0x86, 0x06, 0x85, 0x07, 0x86, 0x06, 0x82, 0x00, 0x83, 0x05, 0x82, 0x01, 0x83,
+	0x04, 0x82, 0x02, 0x83, 0x03, 0x82, 0x03, 0x83, 0x00, 0x01, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03,
+	0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03,
+	0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x01, 0x01, 0x82, 0x01, 0x82, 0x02, 0x84, 0x04, 0x88,
+	0x00, 0x86, 0x03, 0x83, 0x01, 0x84, 0x01, 0x83, 0x03, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x82,
+	0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82,
+	0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82,
+	0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x03, 0x82, 0x01, 0x01, 0x82, 0x01, 0x83, 0x04, 0x89, 0x03,
+	0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02,
+	0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02,
+	0x82, 0x03, 0x83, 0x00, 0x03, 0x85, 0x05, 0x88, 0x04, 0x83, 0x01, 0x83, 0x02, 0x83, 0x03, 0x83,
+	0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83,
+	0x02, 0x83, 0x01, 0x83, 0x03, 0x88, 0x06, 0x85, 0x03, 0x01, 0x82, 0x01, 0x83, 0x04, 0x89, 0x03,
+	0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x82, 0x04, 0x82, 0x02, 0x82, 0x04, 0x82, 0x02,
+	0x82, 0x04, 0x82, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x83, 0x02, 0x89, 0x03, 0x82, 0x01,
+	0x83, 0x04, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x08, 0x03, 0x82, 0x01, 0x83, 0x02, 0x8A,
+	0x02, 0x83, 0x01, 0x84, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83,
+	0x01, 0x83, 0x03, 0x83, 0x01, 0x83, 0x03, 0x83, 0x02, 0x83, 0x01, 0x84, 0x02, 0x8A, 0x04, 0x82,
+	0x01, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x00, 0x01, 0x82, 0x01, 0x82, 0x01,
+	0x87, 0x01, 0x83, 0x05, 0x83, 0x05, 0x82, 0x06, 0x82, 0x06, 0x82, 0x06, 0x82, 0x06, 0x82, 0x06,
+	0x82, 0x06, 0x82, 0x04, 0x02, 0x85, 0x04, 0x87, 0x02, 0x82, 0x04, 0x80, 0x02, 0x82, 0x08, 0x86,
+	0x05, 0x87, 0x05, 0x86, 0x07, 0x83, 0x01, 0x81, 0x03, 0x83, 0x01, 0x88, 0x04, 0x85, 0x02, 0x01,
+	0x83, 0x05, 0x83, 0x05, 0x83, 0x03, 0x88, 0x00, 0x88, 0x02, 0x83, 0x05, 0x83, 0x05, 0x83, 0x05,
+	0x83, 0x05, 0x83, 0x05, 0x83, 0x05, 0x83, 0x05, 0x86, 0x03, 0x85, 0x00, 0x01, 0x82, 0x03, 0x83,
+	0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83,
+	0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x82, 0x03, 0x83, 0x02, 0x83, 0x01, 0x84,
+	0x02, 0x8A, 0x03, 0x83, 0x01, 0x83, 0x00, 0x83, 0x04, 0x83, 0x00, 0x82, 0x04, 0x82, 0x01, 0x83,
+	0x02, 0x83, 0x02, 0x82, 0x02, 0x82, 0x03, 0x82, 0x02, 0x82, 0x03, 0x83, 0x00, 0x83, 0x04, 0x82,
+	0x00, 0x82, 0x05, 0x86, 0x06, 0x84, 0x07, 0x84, 0x07, 0x84, 0x03, 0x00, 0x82, 0x03, 0x82, 0x02,
+	0x83, 0x00, 0x82, 0x02, 0x83, 0x02, 0x82, 0x01, 0x83, 0x01, 0x83, 0x02, 0x82, 0x02, 0x82, 0x01,
+	0x84, 0x01, 0x82, 0x02, 0x82, 0x01, 0x84, 0x00, 0x83, 0x02, 0x82, 0x00, 0x82, 0x00, 0x81, 0x00,
+	0x82, 0x03, 0x85, 0x01, 0x85, 0x04, 0x84, 0x01, 0x85, 0x04, 0x84, 0x01, 0x85, 0x04, 0x84, 0x02,
+	0x83, 0x05, 0x84, 0x02, 0x83, 0x02, 0x00, 0x83, 0x02, 0x83, 0x02, 0x82, 0x02, 0x82, 0x03, 0x83,
+	0x00, 0x83, 0x04, 0x86, 0x06, 0x84, 0x07, 0x84, 0x07, 0x84, 0x06, 0x86, 0x04, 0x83, 0x00, 0x83,
+	0x02, 0x83, 0x02, 0x82, 0x02, 0x82, 0x04, 0x82, 0x00, 0x83, 0x04, 0x82, 0x01, 0x82, 0x04, 0x82,
+	0x01, 0x83, 0x02, 0x83, 0x02, 0x82, 0x02, 0x82, 0x03, 0x83, 0x01, 0x82, 0x04, 0x82, 0x00, 0x83,
+	0x04, 0x82, 0x00, 0x82, 0x05, 0x86, 0x06, 0x84, 0x07, 0x84, 0x08, 0x83, 0x08, 0x82, 0x09, 0x82,
+	0x06, 0x84, 0x07, 0x83, 0x06, 0x00, 0x89, 0x01, 0x89, 0x06, 0x84, 0x05, 0x84, 0x05, 0x84, 0x06,
+	0x83, 0x06, 0x83, 0x06, 0x83, 0x06, 0x83, 0x07, 0x89, 0x01, 0x89, 0x00, 0x06, 0x84, 0x07, 0x85,
+	0x07, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x09, 0x83, 0x09, 0x83, 0x06, 0x85, 0x07, 0x85,
+	0x0A, 0x83, 0x09, 0x83, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x82, 0x0A, 0x85, 0x08, 0x84,
+	0x01, 0x02, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04,
+	0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04,
+	0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x04, 0x81, 0x01, 0x01, 0x84, 0x08, 0x85, 0x0A, 0x83,
+	0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x0A, 0x82, 0x0A, 0x85, 0x07, 0x85, 0x07, 0x82,
+	0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x09, 0x83, 0x06, 0x85, 0x07, 0x84, 0x06, 0x13,
+	0x85, 0x03, 0x81, 0x03, 0x8C, 0x03, 0x81, 0x03, 0x84, 0x58,
+};
+
+constexpr Glyph label_glyphs[] = {
+	{0, 0, 0, 0, 0, 7}, // ' '
+	{0, 9, 15, 0, 4, 9}, // '!'
+	{29, 10, 15, 0, 4, 10}, // '"'
+	{50, 17, 15, 0, 4, 17}, // '#'
+	{103, 14, 18, 0, 4, 14}, // '$'
+	{154, 20, 15, 0, 4, 20}, // '%'
+	{233, 17, 15, 0, 4, 17}, // '&'
+	{284, 6, 15, 0, 4, 6}, // "'"
+	{295, 9, 18, 0, 4, 9}, // '('
+	{332, 9, 18, 0, 4, 9}, // ')'
+	{369, 11, 15, 0, 4, 10}, // '*'
+	{396, 17, 12, 0, 7, 17}, // '+'
+	{421, 8, 7, 0, 15, 8}, // ','
+	{436, 8, 7, 0, 12, 8}, // '-'
+	{443, 8, 4, 0, 15, 8}, // '.'
+	{452, 8, 16, 0, 4, 7}, // '/'
+	{485, 14, 15, 0, 4, 14}, // '0'
+	{538, 14, 15, 0, 4, 14}, // '1'
+	{571, 14, 15, 0, 4, 14}, // '2'
+	{604, 14, 15, 0, 4, 14}, // '3'
+	{639, 14, 15, 0, 4, 14}, // '4'
+	{680, 14, 15, 0, 4, 14}, // '5'
+	{715, 14, 15, 0, 4, 14}, // '6'
+	{762, 14, 15, 0, 4, 14}, // '7'
+	{793, 14, 15, 0, 4, 14}, // '8'
+	{842, 14, 15, 0, 4, 14}, // '9'
+	{889, 8, 11, 0, 8, 8}, // ':'
+	{906, 8, 14, 0, 8, 8}, // ';'
+	{929, 17, 12, 0, 7, 17}, // '<'
+	{952, 17, 9, 0, 10, 17}, // '='
+	{961, 17, 12, 0, 7, 17}, // '>'
+	{984, 12, 15, 0, 4, 12}, // '?'
+	{1015, 20, 18, 0, 4, 20}, // '@'
+	{1112, 16, 15, 0, 4, 15}, // 'A'
+	{1159, 15, 15, 0, 4, 15}, // 'B'
+	{1208, 15, 15, 0, 4, 15}, // 'C'
+	{1243, 17, 15, 0, 4, 17}, // 'D'
+	{1296, 14, 15, 0, 4, 14}, // 'E'
+	{1327, 14, 15, 0, 4, 14}, // 'F'
+	{1358, 16, 15, 0, 4, 16}, // 'G'
+	{1403, 17, 15, 0, 4, 17}, // 'H'
+	{1460, 7, 15, 0, 4, 7}, // 'I'
+	{1491, 9, 19, -2, 4, 7}, // 'J'
+	{1530, 17, 15, 0, 4, 16}, // 'K'
+	{1581, 13, 15, 0, 4, 13}, // 'L'
+	{1612, 20, 15, 0, 4, 20}, // 'M'
+	{1689, 17, 15, 0, 4, 17}, // 'N'
+	{1756, 17, 15, 0, 4, 17}, // 'O'
+	{1809, 15, 15, 0, 4, 15}, // 'P'
+	{1852, 17, 18, 0, 4, 17}, // 'Q'
+	{1911, 15, 15, 0, 4, 15}, // 'R'
+	{1963, 14, 15, 0, 4, 14}, // 'S'
+	{2000, 14, 15, 0, 4, 14}, // 'T'
+	{2028, 16, 15, 0, 4, 16}, // 'U'
+	{2085, 16, 15, 0, 4, 15}, // 'V'
+	{2135, 22, 15, 0, 4, 22}, // 'W'
+	{2224, 16, 15, 0, 4, 15}, // 'X'
+	{2273, 16, 15, -1, 4, 14}, // 'Y'
+	{2314, 15, 15, 0, 4, 15}, // 'Z'
+	{2345, 9, 18, 0, 4, 9}, // '['
+	{2382, 8, 16, 0, 4, 7}, // '\\'
+	{2414, 9, 18, 0, 4, 9}, // ']'
+	{2451, 17, 15, 0, 4, 17}, // '^'
+	{2469, 10, 5, 0, 19, 10}, // '_'
+	{2471, 10, 16, 0, 3, 10}, // '`'
+	{2480, 14, 11, 0, 8, 14}, // 'a'
+	{2511, 14, 15, 0, 4, 14}, // 'b'
+	{2560, 12, 11, 0, 8, 12}, // 'c'
+	{2583, 14, 15, 0, 4, 14}, // 'd'
+	{2632, 14, 11, 0, 8, 14}, // 'e'
+	{2661, 9, 15, 0, 4, 9}, // 'f'
+	{2690, 14, 15, 0, 8, 14}, // 'g'
+	{2741, 14, 15, 0, 4, 14}, // 'h'
+	{2792, 7, 15, 0, 4, 7}, // 'i'
+	{2821, 8, 19, -1, 4, 7}, // 'j'
+	{2858, 14, 15, 0, 4, 13}, // 'k'
+	{2905, 7, 15, 0, 4, 7}, // 'l'
+	{2936, 21, 11, 0, 8, 21}, // 'm'
+	{3001, 14, 11, 0, 8, 14}, // 'n'
+	{3044, 14, 11, 0, 8, 14}, // 'o'
+	{3081, 14, 15, 0, 8, 14}, // 'p'
+	{3130, 14, 15, 0, 8, 14}, // 'q'
+	{3179, 10, 11, 0, 8, 10}, // 'r'
+	{3204, 12, 11, 0, 8, 12}, // 's'
+	{3231, 10, 14, 0, 5, 10}, // 't'
+	{3260, 14, 11, 0, 8, 14}, // 'u'
+	{3303, 13, 11, 0, 8, 13}, // 'v'
+	{3339, 18, 11, 0, 8, 18}, // 'w'
+	{3398, 13, 11, 0, 8, 13}, // 'x'
+	{3433, 13, 15, 0, 8, 13}, // 'y'
+	{3477, 12, 11, 0, 8, 12}, // 'z'
+	{3500, 14, 18, 0, 4, 14}, // '{'
+	{3537, 7, 20, 0, 4, 7}, // '|'
+	{3578, 14, 18, 0, 4, 14}, // '}'
+	{3615, 17, 9, 0, 10, 17}, // '~'
+};
+
+constexpr Kern label_kerns[] = {
+	{45, 84, -3},
+	{45, 86, -1},
+	{45, 87, -1},
+	{45, 88, -2},
+	{45, 89, -3},
+	{65, 84, -2},
+	{65, 85, -1},
+	{65, 86, -1},
+	{65, 87, -1},
+	{65, 89, -2},
+	{65, 118, -1},
+	{65, 121, -1},
+	{66, 86, -1},
+	{66, 87, -1},
+	{66, 89, -1},
+	{68, 89, -1},
+	{70, 44, -3},
+	{70, 45, -1},
+	{70, 46, -3},
+	{70, 58, -1},
+	{70, 59, -1},
+	{70, 65, -2},
+	{70, 97, -1},
+	{70, 101, -1},
+	{70, 111, -1},
+	{70, 114, -1},
+	{70, 117, -1},
+	{70, 121, -1},
+	{75, 45, -2},
+	{75, 67, -1},
+	{75, 79, -1},
+	{75, 121, -1},
+	{76, 79, -1},
+	{76, 84, -3},
+	{76, 85, -1},
+	{76, 86, -3},
+	{76, 87, -2},
+	{76, 89, -3},
+	{76, 121, -1},
+	{79, 65, -1},
+	{79, 86, -1},
+	{79, 88, -1},
+	{79, 89, -1},
+	{80, 44, -4},
+	{80, 46, -4},
+	{80, 65, -2},
+	{80, 97, -1},
+	{82, 84, -1},
+	{82, 89, -1},
+	{82, 121, -1},
+	{83, 83, -1},
+	{84, 44, -3},
+	{84, 45, -3},
+	{84, 46, -3},
+	{84, 58, -1},
+	{84, 59, -1},
+	{84, 65, -2},
+	{84, 97, -3},
+	{84, 99, -3},
+	{84, 101, -3},
+	{84, 111, -3},
+	{84, 114, -2},
+	{84, 115, -3},
+	{84, 117, -2},
+	{84, 119, -2},
+	{84, 121, -2},
+	{85, 65, -1},
+	{86, 44, -3},
+	{86, 45, -1},
+	{86, 46, -3},
+	{86, 58, -1},
+	{86, 59, -1},
+	{86, 65, -1},
+	{86, 97, -1},
+	{86, 101, -1},
+	{86, 111, -1},
+	{86, 117, -1},
+	{87, 44, -2},
+	{87, 45, -1},
+	{87, 46, -2},
+	{87, 58, -1},
+	{87, 59, -1},
+	{87, 65, -1},
+	{87, 97, -1},
+	{87, 101, -1},
+	{87, 111, -1},
+	{88, 45, -2},
+	{88, 67, -1},
+	{88, 79, -1},
+	{88, 101, -1},
+	{89, 44, -3},
+	{89, 45, -3},
+	{89, 46, -3},
+	{89, 58, -2},
+	{89, 59, -2},
+	{89, 65, -2},
+	{89, 67, -1},
+	{89, 79, -1},
+	{89, 97, -2},
+	{89, 101, -2},
+	{89, 111, -2},
+	{89, 117, -1},
+	{97, 121, -1},
+	{102, 44, -1},
+	{102, 46, -1},
+	{107, 101, -1},
+	{107, 111, -1},
+	{114, 44, -3},
+	{114, 46, -3},
+	{118, 44, -2},
+	{118, 46, -2},
+	{119, 44, -1},
+	{119, 46, -1},
+	{121, 44, -2},
+	{121, 46, -2},
+};
+
+constexpr Font FONT_LABEL{label_rle, label_glyphs, label_kerns, 115, &FONT_GLYPH_INDEX, 24};
+
+// DejaVuSans.ttf 14px, 2577 bytes of glyph data
+constexpr uint8_t small_rle[] = {
+	0x01, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03, 0x80, 0x04, 0x80, 0x04, 0x80, 0x10, 0x81, 0x03, 0x81,
+	0x01, 0x00, 0x81, 0x00, 0x80, 0x01, 0x81, 0x00, 0x80, 0x01, 0x81, 0x00, 0x80, 0x01, 0x81, 0x00,
+	0x80, 0x24, 0x04, 0x80, 0x01, 0x80, 0x07, 0x80, 0x01, 0x80, 0x06, 0x81, 0x01, 0x80, 0x04, 0x88,
+	0x04, 0x80, 0x01, 0x80, 0x07, 0x80, 0x01, 0x80, 0x04, 0x88, 0x04, 0x80, 0x01, 0x80, 0x07, 0x80,
+	0x01, 0x80, 0x07, 0x80, 0x01, 0x80, 0x04, 0x03, 0x80, 0x07, 0x80, 0x05, 0x83, 0x03, 0x81, 0x00,
+	0x80, 0x00, 0x80, 0x02, 0x80, 0x01, 0x80, 0x04, 0x81, 0x00, 0x80, 0x05, 0x83, 0x06, 0x80, 0x00,
+	0x80, 0x05, 0x80, 0x00, 0x81, 0x01, 0x80, 0x01, 0x80, 0x00, 0x80, 0x03, 0x84, 0x05, 0x80, 0x07,
+	0x80, 0x03, 0x01, 0x81, 0x04, 0x80, 0x03, 0x80, 0x01, 0x80, 0x02, 0x80, 0x04, 0x80, 0x01, 0x80,
+	0x02, 0x80, 0x04, 0x80, 0x01, 0x80, 0x01, 0x80, 0x05, 0x80, 0x01, 0x80, 0x00, 0x81, 0x00, 0x81,
+	0x03, 0x81, 0x01, 0x80, 0x00, 0x80, 0x01, 0x80, 0x05, 0x80, 0x01, 0x80, 0x01, 0x80, 0x05, 0x80,
+	0x01, 0x80, 0x01, 0x80, 0x04, 0x80, 0x02, 0x80, 0x01, 0x80, 0x03, 0x80, 0x04, 0x82, 0x00, 0x02,
+	0x82, 0x06, 0x81, 0x01, 0x80, 0x05, 0x80, 0x09, 0x81, 0x08, 0x82, 0x06, 0x81, 0x00, 0x81, 0x02,
+	0x80, 0x01, 0x80, 0x02, 0x81, 0x00, 0x81, 0x01, 0x80, 0x03, 0x82, 0x02, 0x81, 0x02, 0x82, 0x04,
+	0x83, 0x00, 0x81, 0x00, 0x00, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x18, 0x02, 0x80, 0x02,
+	0x81, 0x02, 0x80, 0x03, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x03, 0x80, 0x03,
+	0x80, 0x03, 0x81, 0x03, 0x80, 0x00, 0x00, 0x81, 0x03, 0x80, 0x03, 0x81, 0x03, 0x80, 0x03, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x01, 0x02,
+	0x80, 0x03, 0x80, 0x00, 0x80, 0x00, 0x80, 0x02, 0x82, 0x03, 0x82, 0x02, 0x80, 0x00, 0x80, 0x00,
+	0x80, 0x03, 0x80, 0x1E, 0x04, 0x80, 0x0A, 0x80, 0x0A, 0x80, 0x0A, 0x80, 0x06, 0x88, 0x06, 0x80,
+	0x0A, 0x80, 0x0A, 0x80, 0x0A, 0x80, 0x05, 0x01, 0x80, 0x02, 0x80, 0x01, 0x80, 0x01, 0x00, 0x82,
+	0x0F, 0x00, 0x81, 0x01, 0x81, 0x00, 0x02, 0x81, 0x02, 0x80, 0x03, 0x80, 0x03, 0x80, 0x02, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x02, 0x80, 0x03, 0x80, 0x03, 0x80, 0x02, 0x81, 0x02, 0x80, 0x03, 0x02,
+	0x82, 0x04, 0x80, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x04,
+	0x80, 0x01, 0x80, 0x04, 0x80, 0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02,
+	0x80, 0x04, 0x82, 0x02, 0x02, 0x81, 0x05, 0x80, 0x00, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80,
+	0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x05, 0x85, 0x00, 0x01, 0x83, 0x03, 0x80, 0x02,
+	0x81, 0x07, 0x80, 0x07, 0x80, 0x06, 0x81, 0x05, 0x81, 0x05, 0x81, 0x06, 0x80, 0x06, 0x80, 0x06,
+	0x86, 0x00, 0x01, 0x83, 0x03, 0x80, 0x03, 0x80, 0x07, 0x80, 0x07, 0x80, 0x04, 0x82, 0x08, 0x80,
+	0x07, 0x81, 0x06, 0x81, 0x01, 0x80, 0x03, 0x80, 0x03, 0x83, 0x02, 0x04, 0x81, 0x05, 0x82, 0x04,
+	0x80, 0x00, 0x81, 0x03, 0x81, 0x00, 0x81, 0x03, 0x80, 0x01, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02,
+	0x86, 0x05, 0x81, 0x06, 0x81, 0x06, 0x81, 0x01, 0x01, 0x84, 0x03, 0x80, 0x07, 0x80, 0x07, 0x83,
+	0x07, 0x81, 0x07, 0x81, 0x06, 0x81, 0x06, 0x81, 0x01, 0x80, 0x02, 0x81, 0x03, 0x83, 0x02, 0x02,
+	0x83, 0x03, 0x81, 0x05, 0x81, 0x06, 0x81, 0x06, 0x85, 0x02, 0x81, 0x02, 0x81, 0x01, 0x81, 0x03,
+	0x80, 0x01, 0x81, 0x03, 0x80, 0x02, 0x80, 0x02, 0x81, 0x03, 0x83, 0x01, 0x00, 0x86, 0x06, 0x80,
+	0x06, 0x81, 0x06, 0x81, 0x06, 0x80, 0x06, 0x81, 0x06, 0x80, 0x07, 0x80, 0x06, 0x81, 0x06, 0x80,
+	0x04, 0x01, 0x84, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x80, 0x03,
+	0x83, 0x03, 0x81, 0x02, 0x80, 0x02, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x02,
+	0x81, 0x02, 0x84, 0x01, 0x01, 0x83, 0x03, 0x81, 0x02, 0x80, 0x02, 0x80, 0x03, 0x81, 0x01, 0x80,
+	0x03, 0x81, 0x01, 0x81, 0x02, 0x81, 0x02, 0x85, 0x06, 0x81, 0x06, 0x80, 0x06, 0x81, 0x03, 0x83,
+	0x02, 0x01, 0x80, 0x03, 0x80, 0x12, 0x80, 0x03, 0x80, 0x01, 0x01, 0x80, 0x03, 0x80, 0x12, 0x80,
+	0x03, 0x80, 0x02, 0x80, 0x02, 0x08, 0x80, 0x07, 0x83, 0x05, 0x82, 0x06, 0x82, 0x08, 0x82, 0x0A,
+	0x82, 0x0A, 0x83, 0x0A, 0x80, 0x01, 0x00, 0x88, 0x1A, 0x88, 0x25, 0x01, 0x80, 0x0A, 0x82, 0x0B,
+	0x82, 0x0A, 0x82, 0x08, 0x82, 0x06, 0x82, 0x05, 0x82, 0x08, 0x80, 0x08, 0x01, 0x82, 0x02, 0x80,
+	0x02, 0x80, 0x05, 0x80, 0x04, 0x81, 0x03, 0x81, 0x04, 0x80, 0x05, 0x80, 0x0C, 0x80, 0x05, 0x80,
+	0x02, 0x04, 0x84, 0x06, 0x81, 0x03, 0x81, 0x04, 0x80, 0x07, 0x80, 0x02, 0x81, 0x01, 0x82, 0x00,
+	0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x81, 0x01, 0x81, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x03,
+	0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x03, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x81, 0x01,
+	0x81, 0x00, 0x80, 0x02, 0x81, 0x01, 0x82, 0x00, 0x81, 0x04, 0x80, 0x0D, 0x81, 0x03, 0x81, 0x07,
+	0x84, 0x03, 0x03, 0x81, 0x06, 0x82, 0x06, 0x80, 0x00, 0x81, 0x05, 0x80, 0x01, 0x80, 0x04, 0x80,
+	0x02, 0x80, 0x04, 0x80, 0x02, 0x81, 0x02, 0x86, 0x02, 0x80, 0x04, 0x80, 0x02, 0x80, 0x05, 0x80,
+	0x00, 0x81, 0x05, 0x80, 0x00, 0x00, 0x85, 0x03, 0x81, 0x02, 0x81, 0x02, 0x81, 0x03, 0x80, 0x02,
+	0x81, 0x02, 0x81, 0x02, 0x85, 0x03, 0x81, 0x03, 0x80, 0x02, 0x81, 0x03, 0x81, 0x01, 0x81, 0x03,
+	0x81, 0x01, 0x81, 0x03, 0x80, 0x02, 0x85, 0x02, 0x02, 0x84, 0x03, 0x81, 0x03, 0x80, 0x01, 0x81,
+	0x07, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x81, 0x08, 0x81, 0x03, 0x80, 0x03, 0x84,
+	0x01, 0x00, 0x85, 0x04, 0x81, 0x03, 0x81, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x81, 0x01,
+	0x81, 0x04, 0x81, 0x01, 0x81, 0x04, 0x81, 0x01, 0x81, 0x04, 0x81, 0x01, 0x81, 0x04, 0x80, 0x02,
+	0x81, 0x03, 0x81, 0x02, 0x85, 0x03, 0x00, 0x86, 0x01, 0x81, 0x06, 0x81, 0x06, 0x81, 0x06, 0x86,
+	0x01, 0x81, 0x06, 0x81, 0x06, 0x81, 0x06, 0x81, 0x06, 0x86, 0x00, 0x00, 0x85, 0x01, 0x81, 0x05,
+	0x81, 0x05, 0x81, 0x05, 0x85, 0x01, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x04,
+	0x02, 0x84, 0x04, 0x81, 0x03, 0x80, 0x02, 0x81, 0x08, 0x80, 0x09, 0x80, 0x09, 0x80, 0x03, 0x83,
+	0x01, 0x80, 0x05, 0x81, 0x01, 0x81, 0x04, 0x81, 0x02, 0x81, 0x03, 0x81, 0x03, 0x85, 0x01, 0x00,
+	0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x80, 0x02,
+	0x87, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04, 0x80, 0x02, 0x81, 0x04,
+	0x80, 0x02, 0x81, 0x04, 0x80, 0x01, 0x00, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81,
+	0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x00, 0x01, 0x81, 0x02, 0x81, 0x02,
+	0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02,
+	0x81, 0x02, 0x80, 0x01, 0x82, 0x01, 0x00, 0x81, 0x03, 0x81, 0x01, 0x81, 0x02, 0x80, 0x03, 0x81,
+	0x01, 0x80, 0x04, 0x81, 0x00, 0x80, 0x05, 0x82, 0x06, 0x83, 0x05, 0x81, 0x00, 0x81, 0x04, 0x81,
+	0x01, 0x81, 0x03, 0x81, 0x02, 0x81, 0x02, 0x81, 0x03, 0x81, 0x00, 0x00, 0x81, 0x05, 0x81, 0x05,
+	0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x86, 0x00,
+	0x82, 0x03, 0x82, 0x01, 0x82, 0x03, 0x82, 0x01, 0x82, 0x03, 0x82, 0x01, 0x81, 0x00, 0x80, 0x01,
+	0x80, 0x00, 0x81, 0x01, 0x81, 0x00, 0x80, 0x01, 0x80, 0x00, 0x81, 0x01, 0x81, 0x00, 0x81, 0x00,
+	0x80, 0x00, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01,
+	0x81, 0x05, 0x81, 0x01, 0x81, 0x05, 0x81, 0x00, 0x00, 0x82, 0x03, 0x80, 0x01, 0x82, 0x03, 0x80,
+	0x01, 0x83, 0x02, 0x80, 0x01, 0x81, 0x00, 0x80, 0x02, 0x80, 0x01, 0x81, 0x00, 0x81, 0x01, 0x80,
+	0x01, 0x81, 0x01, 0x80, 0x01, 0x80, 0x01, 0x81, 0x01, 0x81, 0x00, 0x80, 0x01, 0x81, 0x02, 0x82,
+	0x01, 0x81, 0x02, 0x82, 0x01, 0x81, 0x03, 0x81, 0x00, 0x02, 0x84, 0x04, 0x81, 0x02, 0x81, 0x02,
+	0x81, 0x04, 0x81, 0x01, 0x80, 0x06, 0x80, 0x01, 0x80, 0x06, 0x80, 0x01, 0x80, 0x06, 0x80, 0x01,
+	0x80, 0x06, 0x80, 0x01, 0x81, 0x04, 0x81, 0x02, 0x81, 0x02, 0x81, 0x04, 0x84, 0x02, 0x00, 0x85,
+	0x01, 0x81, 0x02, 0x81, 0x00, 0x81, 0x02, 0x81, 0x00, 0x81, 0x02, 0x81, 0x00, 0x81, 0x02, 0x81,
+	0x00, 0x85, 0x01, 0x81, 0x05, 0x81, 0x05, 0x81, 0x05, 0x81, 0x04, 0x02, 0x84, 0x04, 0x81, 0x02,
+	0x81, 0x02, 0x81, 0x04, 0x81, 0x01, 0x80, 0x06, 0x80, 0x01, 0x80, 0x06, 0x80, 0x01, 0x80, 0x06,
+	0x80, 0x01, 0x80, 0x06, 0x80, 0x01, 0x81, 0x04, 0x81, 0x02, 0x81, 0x02, 0x81, 0x04, 0x84, 0x08,
+	0x81, 0x09, 0x81, 0x01, 0x00, 0x85, 0x03, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81,
+	0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x85, 0x03, 0x81, 0x02, 0x80, 0x03, 0x81, 0x02, 0x81,
+	0x02, 0x81, 0x03, 0x81, 0x01, 0x81, 0x04, 0x80, 0x00, 0x01, 0x83, 0x03, 0x81, 0x06, 0x80, 0x07,
+	0x81, 0x07, 0x82, 0x07, 0x82, 0x07, 0x81, 0x07, 0x80, 0x01, 0x80, 0x03, 0x81, 0x02, 0x84, 0x01,
+	0x00, 0x88, 0x04, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80,
+	0x08, 0x80, 0x08, 0x80, 0x03, 0x00, 0x81, 0x04, 0x80, 0x01, 0x81, 0x04, 0x80, 0x01, 0x81, 0x04,
+	0x80, 0x01, 0x81, 0x04, 0x80, 0x01, 0x81, 0x04, 0x80, 0x01, 0x81, 0x04, 0x80, 0x01, 0x81, 0x04,
+	0x80, 0x01, 0x81, 0x03, 0x81, 0x02, 0x81, 0x02, 0x80, 0x04, 0x83, 0x02, 0x81, 0x05, 0x80, 0x01,
+	0x80, 0x04, 0x81, 0x01, 0x81, 0x03, 0x80, 0x02, 0x81, 0x03, 0x80, 0x03, 0x80, 0x02, 0x81, 0x03,
+	0x81, 0x01, 0x80, 0x05, 0x80, 0x01, 0x80, 0x05, 0x80, 0x00, 0x81, 0x05, 0x82, 0x07, 0x81, 0x03,
+	0x00, 0x80, 0x03, 0x81, 0x03, 0x80, 0x01, 0x80, 0x03, 0x81, 0x03, 0x80, 0x01, 0x80, 0x03, 0x81,
+	0x02, 0x81, 0x01, 0x81, 0x01, 0x80, 0x00, 0x81, 0x01, 0x80, 0x03, 0x80, 0x01, 0x80, 0x01, 0x80,
+	0x01, 0x80, 0x03, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x03, 0x83, 0x01, 0x80, 0x00, 0x81,
+	0x03, 0x82, 0x02, 0x82, 0x05, 0x81, 0x03, 0x81, 0x05, 0x81, 0x03, 0x81, 0x02, 0x00, 0x81, 0x03,
+	0x81, 0x02, 0x80, 0x02, 0x81, 0x04, 0x80, 0x01, 0x80, 0x05, 0x82, 0x07, 0x81, 0x07, 0x81, 0x06,
+	0x80, 0x00, 0x81, 0x04, 0x81, 0x01, 0x80, 0x03, 0x81, 0x03, 0x80, 0x02, 0x80, 0x04, 0x81, 0x00,
+	0x00, 0x81, 0x04, 0x80, 0x02, 0x80, 0x03, 0x81, 0x03, 0x80, 0x01, 0x81, 0x04, 0x81, 0x00, 0x80,
+	0x06, 0x81, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x08, 0x80, 0x03, 0x00, 0x87, 0x07,
+	0x80, 0x07, 0x81, 0x06, 0x81, 0x06, 0x81, 0x06, 0x81, 0x07, 0x80, 0x07, 0x81, 0x06, 0x81, 0x07,
+	0x87, 0x00, 0x00, 0x82, 0x01, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x82, 0x00, 0x80, 0x03, 0x81, 0x03, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x04, 0x80, 0x03, 0x80, 0x03, 0x80, 0x04, 0x80, 0x03, 0x80, 0x03, 0x80,
+	0x03, 0x81, 0x00, 0x82, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x01, 0x82, 0x00, 0x04, 0x81, 0x08, 0x83, 0x06,
+	0x80, 0x02, 0x81, 0x04, 0x80, 0x04, 0x81, 0x49, 0x12, 0x86, 0x00, 0x01, 0x80, 0x05, 0x80, 0x06,
+	0x80, 0x3A, 0x00, 0x84, 0x07, 0x81, 0x07, 0x80, 0x03, 0x84, 0x02, 0x81, 0x02, 0x80, 0x02, 0x80,
+	0x03, 0x80, 0x02, 0x81, 0x01, 0x81, 0x03, 0x82, 0x00, 0x80, 0x01, 0x00, 0x81, 0x06, 0x81, 0x06,
+	0x81, 0x06, 0x85, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x03, 0x80, 0x01, 0x81, 0x03, 0x80, 0x01,
+	0x81, 0x03, 0x80, 0x01, 0x81, 0x03, 0x80, 0x01, 0x81, 0x02, 0x80, 0x02, 0x85, 0x01, 0x02, 0x82,
+	0x02, 0x81, 0x02, 0x80, 0x01, 0x80, 0x06, 0x80, 0x06, 0x80, 0x06, 0x80, 0x06, 0x81, 0x02, 0x80,
+	0x03, 0x82, 0x01, 0x05, 0x81, 0x06, 0x81, 0x06, 0x81, 0x02, 0x85, 0x01, 0x81, 0x01, 0x82, 0x01,
+	0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01,
+	0x81, 0x01, 0x82, 0x02, 0x85, 0x00, 0x02, 0x82, 0x04, 0x80, 0x02, 0x80, 0x02, 0x80, 0x04, 0x80,
+	0x01, 0x86, 0x01, 0x80, 0x07, 0x80, 0x07, 0x81, 0x08, 0x83, 0x01, 0x01, 0x82, 0x02, 0x80, 0x04,
+	0x80, 0x02, 0x84, 0x02, 0x80, 0x04, 0x80, 0x04, 0x80, 0x04, 0x80, 0x04, 0x80, 0x04, 0x80, 0x04,
+	0x80, 0x02, 0x01, 0x85, 0x01, 0x81, 0x01, 0x82, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81,
+	0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x01, 0x82, 0x02, 0x85, 0x06, 0x80,
+	0x06, 0x81, 0x03, 0x83, 0x02, 0x00, 0x81, 0x06, 0x81, 0x06, 0x81, 0x06, 0x85, 0x02, 0x81, 0x02,
+	0x80, 0x02, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02,
+	0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x00, 0x00, 0x81, 0x01, 0x81, 0x05, 0x81,
+	0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x00, 0x01,
+	0x81, 0x02, 0x81, 0x07, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x81, 0x02,
+	0x81, 0x02, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x01, 0x00, 0x81, 0x06, 0x81, 0x06, 0x81,
+	0x06, 0x81, 0x02, 0x80, 0x02, 0x81, 0x01, 0x80, 0x03, 0x81, 0x00, 0x80, 0x04, 0x82, 0x05, 0x83,
+	0x04, 0x81, 0x00, 0x81, 0x03, 0x81, 0x01, 0x81, 0x02, 0x81, 0x02, 0x81, 0x00, 0x00, 0x81, 0x01,
+	0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01, 0x81, 0x01,
+	0x81, 0x01, 0x81, 0x00, 0x00, 0x85, 0x00, 0x82, 0x03, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81,
+	0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x80,
+	0x02, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81,
+	0x02, 0x80, 0x01, 0x00, 0x85, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02,
+	0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02,
+	0x81, 0x00, 0x01, 0x83, 0x03, 0x81, 0x01, 0x81, 0x02, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81,
+	0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x02, 0x80, 0x03, 0x83, 0x02, 0x00,
+	0x85, 0x02, 0x81, 0x02, 0x80, 0x02, 0x81, 0x03, 0x80, 0x01, 0x81, 0x03, 0x80, 0x01, 0x81, 0x03,
+	0x80, 0x01, 0x81, 0x03, 0x80, 0x01, 0x81, 0x02, 0x80, 0x02, 0x85, 0x02, 0x81, 0x06, 0x81, 0x06,
+	0x81, 0x05, 0x01, 0x85, 0x01, 0x81, 0x01, 0x82, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81,
+	0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x01, 0x82, 0x02, 0x85, 0x06, 0x81,
+	0x06, 0x81, 0x06, 0x81, 0x00, 0x00, 0x84, 0x00, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03,
+	0x81, 0x03, 0x81, 0x03, 0x81, 0x02, 0x01, 0x82, 0x02, 0x80, 0x02, 0x80, 0x01, 0x80, 0x05, 0x82,
+	0x05, 0x82, 0x05, 0x81, 0x00, 0x80, 0x02, 0x80, 0x02, 0x83, 0x00, 0x00, 0x81, 0x03, 0x81, 0x02,
+	0x84, 0x01, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03, 0x81, 0x03, 0x81, 0x04, 0x82, 0x00,
+	0x00, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81, 0x01, 0x80, 0x03, 0x81,
+	0x01, 0x80, 0x03, 0x81, 0x01, 0x81, 0x02, 0x81, 0x01, 0x81, 0x02, 0x81, 0x02, 0x85, 0x00, 0x00,
+	0x80, 0x03, 0x81, 0x00, 0x80, 0x03, 0x80, 0x01, 0x81, 0x02, 0x80, 0x02, 0x80, 0x01, 0x81, 0x02,
+	0x80, 0x01, 0x80, 0x03, 0x81, 0x00, 0x80, 0x04, 0x82, 0x04, 0x81, 0x02, 0x00, 0x80, 0x02, 0x81,
+	0x01, 0x81, 0x00, 0x80, 0x02, 0x81, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x00, 0x80, 0x01, 0x80,
+	0x01, 0x81, 0x00, 0x80, 0x00, 0x80, 0x01, 0x80, 0x02, 0x80, 0x00, 0x80, 0x00, 0x83, 0x02, 0x82,
+	0x01, 0x81, 0x03, 0x81, 0x02, 0x81, 0x03, 0x81, 0x02, 0x81, 0x01, 0x00, 0x80, 0x03, 0x80, 0x02,
+	0x80, 0x01, 0x81, 0x02, 0x83, 0x04, 0x81, 0x05, 0x81, 0x04, 0x81, 0x00, 0x80, 0x02, 0x81, 0x01,
+	0x81, 0x01, 0x80, 0x03, 0x80, 0x00, 0x00, 0x80, 0x03, 0x81, 0x00, 0x80, 0x03, 0x80, 0x01, 0x81,
+	0x02, 0x80, 0x02, 0x80, 0x01, 0x81, 0x02, 0x80, 0x01, 0x80, 0x04, 0x82, 0x04, 0x81, 0x05, 0x81,
+	0x05, 0x81, 0x05, 0x80, 0x04, 0x81, 0x04, 0x00, 0x85, 0x04, 0x80, 0x04, 0x81, 0x03, 0x81, 0x03,
+	0x81, 0x04, 0x80, 0x04, 0x80, 0x05, 0x85, 0x04, 0x81, 0x05, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07,
+	0x80, 0x06, 0x81, 0x05, 0x81, 0x07, 0x81, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x08,
+	0x81, 0x01, 0x01, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80,
+	0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x03, 0x80, 0x01, 0x01,
+	0x81, 0x07, 0x81, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x07, 0x80, 0x08, 0x81, 0x05, 0x80, 0x07,
+	0x80, 0x07, 0x80, 0x07, 0x80, 0x06, 0x81, 0x05, 0x81, 0x04, 0x0D, 0x83, 0x02, 0x80, 0x07, 0x82,
+	0x26,
+};
+
+constexpr Glyph small_glyphs[] = {
+	{0, 0, 0, 0, 0, 4}, // ' '
+	{0, 6, 10, 0, 3, 6}, // '!'
+	{17, 6, 10, 0, 3, 6}, // '"'
+	{34, 12, 10, 0, 3, 12}, // '#'
+	{71, 9, 13, 0, 2, 9}, // '$'
+	{114, 13, 10, 0, 3, 13}, // '%'
+	{175, 11, 10, 0, 3, 11}, // '&'
+	{212, 4, 10, 0, 3, 4}, // "'"
+	{221, 5, 12, 0, 2, 5}, // '('
+	{246, 5, 12, 0, 2, 5}, // ')'
+	{271, 7, 10, 0, 3, 7}, // '*'
+	{292, 12, 9, 0, 4, 12}, // '+'
+	{311, 4, 3, 0, 11, 4}, // ','
+	{318, 5, 4, 0, 9, 5}, // '-'
+	{321, 4, 2, 0, 11, 4}, // '.'
+	{326, 5, 12, 0, 3, 5}, // '/'
+	{351, 9, 10, 0, 3, 9}, // '0'
+	{388, 9, 10, 0, 3, 9}, // '1'
+	{411, 9, 10, 0, 3, 9}, // '2'
+	{434, 9, 10, 0, 3, 9}, // '3'
+	{459, 9, 10, 0, 3, 9}, // '4'
+	{488, 9, 10, 0, 3, 9}, // '5'
+	{511, 9, 10, 0, 3, 9}, // '6'
+	{540, 9, 10, 0, 3, 9}, // '7'
+	{561, 9, 10, 0, 3, 9}, // '8'
+	{596, 9, 10, 0, 3, 9}, // '9'
+	{625, 5, 7, 0, 6, 5}, // ':'
+	{634, 5, 8, 0, 6, 5}, // ';'
+	{645, 12, 8, 0, 5, 12}, // '<'
+	{662, 12, 7, 0, 6, 12}, // '='
+	{667, 12, 8, 0, 5, 12}, // '>'
+	{684, 7, 10, 0, 3, 7}, // '?'
+	{705, 14, 12, 0, 3, 14}, // '@'
+	{770, 10, 10, 0, 3, 10}, // 'A'
+	{805, 10, 10, 0, 3, 10}, // 'B'
+	{840, 10, 10, 0, 3, 10}, // 'C'
+	{865, 11, 10, 0, 3, 11}, // 'D'
+	{902, 9, 10, 0, 3, 9}, // 'E'
+	{923, 8, 10, 0, 3, 8}, // 'F'
+	{944, 11, 10, 0, 3, 11}, // 'G'
+	{975, 11, 10, 0, 3, 11}, // 'H'
+	{1014, 4, 10, 0, 3, 4}, // 'I'
+	{1035, 5, 13, -1, 3, 4}, // 'J'
+	{1062, 10, 10, 0, 3, 9}, // 'K'
+	{1099, 8, 10, 0, 3, 8}, // 'L'
+	{1119, 12, 10, 0, 3, 12}, // 'M'
+	{1176, 10, 10, 0, 3, 10}, // 'N'
+	{1225, 11, 10, 0, 3, 11}, // 'O'
+	{1262, 8, 10, 0, 3, 8}, // 'P'
+	{1291, 11, 12, 0, 3, 11}, // 'Q'
+	{1332, 10, 10, 0, 3, 10}, // 'R'
+	{1369, 9, 10, 0, 3, 9}, // 'S'
+	{1392, 10, 10, -1, 3, 9}, // 'T'
+	{1413, 10, 10, 0, 3, 10}, // 'U'
+	{1452, 10, 10, 0, 3, 10}, // 'V'
+	{1488, 14, 10, 0, 3, 14}, // 'W'
+	{1549, 10, 10, 0, 3, 10}, // 'X'
+	{1584, 10, 10, -1, 3, 9}, // 'Y'
+	{1613, 10, 10, 0, 3, 10}, // 'Z'
+	{1634, 5, 12, 0, 2, 5}, // '['
+	{1659, 5, 12, 0, 3, 5}, // '\\'
+	{1682, 5, 12, 0, 2, 5}, // ']'
+	{1707, 12, 10, 0, 3, 12}, // '^'
+	{1720, 9, 3, -1, 13, 7}, // '_'
+	{1723, 7, 11, 0, 2, 7}, // '`'
+	{1730, 9, 8, 0, 5, 9}, // 'a'
+	{1755, 9, 11, 0, 2, 9}, // 'b'
+	{1790, 8, 8, 0, 5, 8}, // 'c'
+	{1811, 9, 11, 0, 2, 9}, // 'd'
+	{1846, 9, 8, 0, 5, 9}, // 'e'
+	{1867, 6, 11, 0, 2, 5}, // 'f'
+	{1890, 9, 11, 0, 5, 9}, // 'g'
+	{1925, 9, 11, 0, 2, 9}, // 'h'
+	{1962, 4, 11, 0, 2, 4}, // 'i'
+	{1983, 5, 14, -1, 2, 4}, // 'j'
+	{2010, 9, 11, 0, 2, 8}, // 'k'
+	{2045, 4, 11, 0, 2, 4}, // 'l'
+	{2068, 14, 8, 0, 5, 14}, // 'm'
+	{2115, 9, 8, 0, 5, 9}, // 'n'
+	{2146, 9, 8, 0, 5, 9}, // 'o'
+	{2175, 9, 11, 0, 5, 9}, // 'p'
+	{2210, 9, 11, 0, 5, 9}, // 'q'
+	{2245, 6, 8, 0, 5, 6}, // 'r'
+	{2262, 7, 8, 0, 5, 7}, // 's'
+	{2283, 6, 10, 0, 3, 5}, // 't'
+	{2304, 9, 8, 0, 5, 9}, // 'u'
+	{2335, 8, 8, 0, 5, 8}, // 'v'
+	{2364, 11, 8, 0, 5, 11}, // 'w'
+	{2411, 8, 8, 0, 5, 8}, // 'x'
+	{2438, 8, 11, 0, 5, 8}, // 'y'
+	{2471, 7, 8, 0, 5, 7}, // 'z'
+	{2487, 9, 13, 0, 2, 9}, // '{'
+	{2514, 5, 14, 0, 2, 5}, // '|'
+	{2543, 9, 13, 0, 2, 9}, // '}'
+	{2570, 12, 6, 0, 7, 12}, // '~'
+};
+
+constexpr Kern small_kerns[] = {
+	{45, 71, 1},
+	{45, 74, 1},
+	{45, 81, 1},
+	{45, 84, -1},
+	{45, 86, -1},
+	{45, 87, -1},
+	{45, 88, -1},
+	{45, 89, -2},
+	{65, 84, -1},
+	{65, 86, -1},
+	{65, 87, -1},
+	{65, 89, -1},
+	{65, 118, -1},
+	{65, 119, -1},
+	{65, 121, -1},
+	{66, 89, -1},
+	{68, 89, -1},
+	{70, 46, -2},
+	{70, 58, -1},
+	{70, 65, -1},
+	{70, 97, -1},
+	{70, 101, -1},
+	{70, 105, -1},
+	{70, 114, -1},
+	{70, 117, -1},
+	{70, 121, -1},
+	{71, 89, -1},
+	{75, 45, -1},
+	{75, 67, -1},
+	{75, 79, -1},
+	{75, 84, -1},
+	{75, 101, -1},
+	{75, 111, -1},
+	{75, 117, -1},
+	{75, 121, -1},
+	{76, 84, -2},
+	{76, 85, -1},
+	{76, 86, -2},
+	{76, 87, -1},
+	{76, 89, -2},
+	{76, 121, -1},
+	{79, 46, -1},
+	{79, 88, -1},
+	{79, 89, -1},
+	{80, 46, -2},
+	{80, 65, -1},
+	{80, 97, -1},
+	{82, 45, -1},
+	{82, 65, -1},
+	{82, 67, -1},
+	{82, 84, -1},
+	{82, 86, -1},
+	{82, 87, -1},
+	{82, 89, -1},
+	{82, 101, -1},
+	{82, 111, -1},
+	{82, 117, -1},
+	{82, 121, -1},
+	{84, 45, -1},
+	{84, 46, -2},
+	{84, 58, -2},
+	{84, 65, -1},
+	{84, 67, -1},
+	{84, 97, -2},
+	{84, 99, -2},
+	{84, 101, -2},
+	{84, 111, -2},
+	{84, 114, -2},
+	{84, 115, -2},
+	{84, 117, -2},
+	{84, 119, -2},
+	{84, 121, -2},
+	{86, 45, -1},
+	{86, 46, -2},
+	{86, 58, -1},
+	{86, 65, -1},
+	{86, 97, -1},
+	{86, 101, -1},
+	{86, 111, -1},
+	{86, 117, -1},
+	{87, 45, -1},
+	{87, 46, -2},
+	{87, 58, -1},
+	{87, 65, -1},
+	{87, 97, -1},
+	{87, 101, -1},
+	{87, 111, -1},
+	{87, 114, -1},
+	{88, 45, -1},
+	{88, 67, -1},
+	{88, 79, -1},
+	{88, 101, -1},
+	{89, 45, -2},
+	{89, 46, -3},
+	{89, 58, -2},
+	{89, 65, -1},
+	{89, 67, -1},
+	{89, 79, -1},
+	{89, 97, -2},
+	{89, 101, -2},
+	{89, 111, -2},
+	{89, 117, -2},
+	{102, 45, -1},
+	{102, 46, -1},
+	{114, 45, -1},
+	{114, 46, -1},
+	{118, 46, -1},
+	{118, 58, -1},
+	{119, 46, -1},
+	{119, 58, -1},
+	{121, 46, -2},
+	{121, 58, -1},
+};
+
+constexpr Font FONT_SMALL{small_rle, small_glyphs, small_kerns, 112, &FONT_GLYPH_INDEX, 17};
@@ -1,4 +1,6 @@
 #include "main.h"
+#include "axis_tracker.hpp"
+#include "servo.hpp"
 #include <string.h>
 #include <cstdio>
 
@@ -12,159 +14,580 @@ typedef struct {
 
 // class for camera/servo gimbal system
 class Gimbal {
+public:
+    // which block is followed when the camera sees more than one listener
+    enum TARGET_POLICY : uint8_t {
+        LARGEST = 0,
+        NEAREST_CENTER = 1, // least servo travel
+        STICKY = 2 // keeps the same listener by tracking index until the camera loses it
+    };
+
+    enum AXIS : uint8_t {
+        PAN = 0,
+        TILT = 1,
+        NUM_AXES = 2
+    };
+
+    // camera to servo mapping found by calibrate(), saved as is on the SD card
+    struct Calibration {
+        uint32_t magic;
+        int32_t sign[NUM_AXES]; // see AxisTracker::Config
+        int32_t ccr_per_px_q8[NUM_AXES];
+    };
+
 private:
-    TIM_HandleTypeDef* servo_tim; // servo timer handle
+    static const uint32_t SERVO_PWM_HZ = 400; // TIM4 period, the servo ramps are stepped at this rate
+    Servos servos; // both servos on TIM4
+    int8_t servo_idx[NUM_AXES];
     TIM_HandleTypeDef* cam_tim; // camera interrupt timer handle
     UART_HandleTypeDef* uart; // uart handle
-    uint16_t max_step; // max CCR step size for the servos
-    float smooth_x; // smoothed value for x direction (value after alpha is applied)
-    float smooth_y; // smoothed value for y direction (value after alpha is applied)
-    float alpha; // smoothing factor to reduce jumping from camera jitter
-    uint16_t A_v; // new CCR value for vertical servo
-    uint16_t A_h; // new CCR value for horizontal servo
+    AxisTracker pan; // horizontal servo on channel 2, follows x
+    AxisTracker tilt; // vertical servo on channel 1, follows y
     static const uint16_t DMA_RX_BUFFER_SIZE = 256; // chat suggested a size of 256 for this
-    uint8_t dma_rx_buf[DMA_RX_BUFFER_SIZE]; // buffer for incoming RX data
-    uint16_t dma_last_pos = 0; // last position read in dma buffer
-    uint8_t frame_buf[32]; // array of bytes for PixyBlock
-    uint8_t frame_pos = 0; // tracks the number of bytes stored so far in frame_buf
+    static const uint16_t RX_MASK = DMA_RX_BUFFER_SIZE - 1; // size must stay a power of two
+    static const uint8_t BLOCK_LENGTH = 14; // payload bytes of one block
+    static const uint8_t TYPE_BLOCKS = 0x21; // getBlocks response
+    static const uint8_t TYPE_RESULT = 0x03; // 4 byte result instead of blocks, BUSY when there is no new frame yet
+    static const int32_t RESULT_BUSY = -2;
+    static const uint8_t MAX_BLOCKS = 8; // asked for per request, a full frame stays under half the buffer
+    static const uint16_t TARGET_SIG = 1; // signature the camera is trained on
+    static const uint8_t MIN_STICKY_AGE = 3; // frames a new block must have been seen for to take over a lost target
+    static const uint8_t STICKY_MISS_FRAMES = 10; // frames the followed block can be missing before another takes over
+    static const uint32_t REQUEST_TIMEOUT_MS = 20; // a request with no answer by then is sent again
+    uint8_t dma_rx_buf[DMA_RX_BUFFER_SIZE]; // circular buffer the RX DMA writes into, frames are parsed in place
     uint8_t tx_buff[6]; // buffer for sending over TX line
 
-    // parses raw bytes of b and stores data in PixyBlock
-    bool parse_one_block(const uint8_t *b, PixyBlock *o) {
-        if (b[0] != 0xAF || b[1] != 0xC1 || b[2] != 0x21 || b[3] != 0x0E)
-            return false;
+    // header search, each state is the next byte expected
+    enum PARSE_STATE : uint8_t {
+        SYNC0, // 0xAF
+        SYNC1, // 0xC1
+        TYPE, // 0x21 blocks or 0x03 result
+        LENGTH, // 14 per block, up to MAX_BLOCKS, or 4 for a result
+        PAYLOAD // checksum and blocks or result, parsed once all of it is in the buffer
+    };
+    PARSE_STATE parse_state;
+    uint16_t rd_pos; // next byte of dma_rx_buf not yet looked at
+    uint16_t frame_start; // position of the checksum once the header matched
+    uint8_t frame_type;
+    uint8_t frame_len; // payload bytes of the frame being parsed
+
+    // the next request goes out as soon as blocks are parsed, the camera tick resends lost ones and the ones a BUSY
+    // held back
+    bool request_pending;
+    uint32_t request_tick;
 
-        uint16_t chk = b[4] | (b[5] << 8);
+    TARGET_POLICY policy;
+    bool have_sticky;
+    uint8_t sticky_idx; // tracking index of the block followed last
+    uint8_t sticky_missed; // frames in a row without sticky_idx
+
+    // rx stats, reset by report()
+    volatile uint32_t rx_events; // IDLE, half and full events that woke the parser
+    uint32_t frames;
+    uint32_t busy; // BUSY results, requests that came before the next frame was ready
+    uint32_t blocks;
+    uint32_t parse_cycles;
+    uint32_t max_parse_cycles;
+    uint32_t stats_start;
+    // tuned with gimbal_sim. the deadband already covers the offset an I term would remove, and the D term only
+    // added to the overshoot. 3 ticks of lead cover the servo still ramping toward the last moves
+    static constexpr AxisTracker::Gains DEFAULT_GAINS = {179, 16, 102, 0, 0, 3}; // alpha .7 beta .06, kp .4
+    // exposure, the 20ms the pixy takes to process a frame and the wait for the next request, in camera ticks
+    static constexpr uint32_t CAMERA_LATENCY_TICKS = 3;
+    static const uint32_t TARGET_TIMEOUT_MS = 500; // how long after the last block the target counts as lost
+    uint32_t last_target_tick; // HAL tick of the last block with our signature
+    uint32_t target_seq; // counts blocks handed to the trackers
+    uint16_t target_x;
+    uint16_t target_y;
+
+    // calibration nudges one servo at a time through CAL_OFFSETS around where it started and fits the pixel
+    // shift per us, the target has to hold still in view meanwhile
+    static constexpr uint32_t CAL_MAGIC = 0x31434743; // "GCC1"
+    static constexpr int NUM_CAL_POINTS = 5;
+    static constexpr int32_t CAL_OFFSETS[NUM_CAL_POINTS] = {0, 20, 40, -20, -40};
+    static constexpr uint32_t CAL_SETTLE_TICKS = 30; // servo and camera latency
+    static constexpr uint32_t CAL_SAMPLE_TICKS = 20;
+    static constexpr uint32_t CAL_MIN_SAMPLES = 5;
+    static constexpr int32_t CAL_MIN_CCR_PER_PX_Q8 = 26; // 0.1us, anything outside is a bad fit
+    static constexpr int32_t CAL_MAX_CCR_PER_PX_Q8 = 2560;
+    enum CAL_STATE : uint8_t {
+        CAL_IDLE,
+        CAL_SETTLE,
+        CAL_SAMPLE
+    };
+    CAL_STATE cal_state;
+    uint8_t cal_axis;
+    uint8_t cal_point;
+    uint32_t cal_ticks;
+    uint32_t cal_seq; // target_seq already sampled
+    int32_t cal_home[NUM_AXES]; // pulses the servos started from
+    int32_t cal_sum;
+    uint32_t cal_samples;
+    float cal_px[NUM_CAL_POINTS]; // mean target position at each offset
+    Calibration calibration;
+    bool calibration_done;
+
+    // byte i of the ring counted from pos, wraps past the end of the buffer
+    uint8_t ring(uint16_t pos, uint16_t i) const {
+        return dma_rx_buf[(pos + i) & RX_MASK];
+    }
+
+    uint16_t ring16(uint16_t pos, uint16_t i) const {
+        return ring(pos, i) | (ring(pos, i + 1) << 8);
+    }
+
+    // reads the block starting at pos straight out of the DMA buffer
+    void parse_one_block(uint16_t pos, PixyBlock *o) {
+        o->sig   = ring16(pos, 0);
+        o->x     = ring16(pos, 2);
+        o->y     = ring16(pos, 4);
+        o->w     = ring16(pos, 6);
+        o->h     = ring16(pos, 8);
+        o->angle = ring16(pos, 10);
+        o->idx   = ring(pos, 12);
+        o->age   = ring(pos, 13);
+    }
+
+    // higher is a better target under the current policy
+    uint32_t score(const PixyBlock &blk) {
+        uint32_t area = static_cast<uint32_t>(blk.w) * blk.h;
+        if (policy == NEAREST_CENTER) {
+            // in half pixels so the 157.5, 103.5 center stays whole
+            int32_t dx = 2 * blk.x - 315;
+            int32_t dy = 2 * blk.y - 207;
+            return UINT32_MAX - static_cast<uint32_t>(dx * dx + dy * dy);
+        }
+        if (policy == STICKY) {
+            // the block followed last wins, then ones the camera has seen for a while, then the largest
+            if (area >= (1u << 30)) area = (1u << 30) - 1;
+            return (have_sticky && blk.idx == sticky_idx ? 1u << 31 : 0) | (blk.age >= MIN_STICKY_AGE ? 1u << 30 : 0) | area;
+        }
+        return area;
+    }
+
+    // checks the frame starting at its checksum, picks one block and hands it to the trackers, the servos
+    // only move on the next control_step()
+    void handle_frame(uint16_t pos, uint8_t len) {
+        uint16_t chk = ring16(pos, 0);
         uint16_t sum = 0;
-        for (int i = 6; i < 20; ++i) sum += b[i];
+        for (int i = 2; i < 2 + len; ++i) sum += ring(pos, i);
         if (sum != chk)
-            return false;
+            return;
 
-        o->sig   = b[6]  | (b[7]  << 8);
-        o->x     = b[8]  | (b[9]  << 8);
-        o->y     = b[10] | (b[11] << 8);
-        o->w     = b[12] | (b[13] << 8);
-        o->h     = b[14] | (b[15] << 8);
-        o->angle = b[16] | (b[17] << 8);
-        o->idx   = b[18];
-        o->age   = b[19];
+        bool found = false;
+        bool sticky_seen = false;
+        PixyBlock best;
+        uint32_t best_score = 0;
+        for (uint8_t off = 2; off < 2 + len; off += BLOCK_LENGTH) {
+            PixyBlock p;
+            parse_one_block(pos + off, &p);
+            ++blocks;
+            if (p.sig != TARGET_SIG)
+                continue;
+            if (have_sticky && p.idx == sticky_idx)
+                sticky_seen = true;
+            uint32_t s = score(p);
+            if (!found || s > best_score) {
+                found = true;
+                best = p;
+                best_score = s;
+            }
+        }
+        // a dropped frame or the listener passing behind someone is no reason to switch, the trackers coast until
+        // the block is back. once it has been gone for STICKY_MISS_FRAMES, or TARGET_TIMEOUT_MS without any
+        // block, age and area pick the next one
+        if (policy == STICKY && have_sticky && !sticky_seen) {
+            if (++sticky_missed < STICKY_MISS_FRAMES)
+                return;
+            have_sticky = false;
+        }
+        if (!found)
+            return;
 
+        have_sticky = true;
+        sticky_idx = best.idx;
+        sticky_missed = 0;
+        last_target_tick = HAL_GetTick();
+        ++target_seq;
+        target_x = best.x;
+        target_y = best.y;
+        pan.measure(best.x);
+        tilt.measure(best.y);
+    }
+
+    // a result frame in place of blocks, only BUSY is expected, anything else is printed
+    void handle_result(uint16_t pos) {
+        uint16_t sum = 0;
+        for (int i = 2; i < 6; ++i) sum += ring(pos, i);
+        if (sum != ring16(pos, 0))
+            return;
+        int32_t result = static_cast<int32_t>(ring16(pos, 2) | (static_cast<uint32_t>(ring16(pos, 4)) << 16));
+        if (result == RESULT_BUSY)
+            ++busy;
+        else
+            printf("Pixy result %ld\r\n", result);
+    }
+
+    AxisTracker& axis_tracker(uint8_t axis) {
+        return axis == PAN ? pan : tilt;
+    }
+
+    // an axis whose servo failed to add is skipped
+    void set_servo(uint8_t axis, int32_t ccr) {
+        if (servo_idx[axis] < 0)
+            return;
+        servos[servo_idx[axis]].set_target_us(ccr);
+    }
+
+    void end_calibration() {
+        cal_state = CAL_IDLE;
+        set_servo(PAN, cal_home[PAN]);
+        set_servo(TILT, cal_home[TILT]);
+        pan.lose();
+        tilt.lose();
+    }
+
+    // least squares line through the points of the axis, false if it does not look like a clean linear response
+    bool fit_axis() {
+        float mean_off = 0, mean_px = 0;
+        for (int i = 0; i < NUM_CAL_POINTS; ++i) {
+            mean_off += CAL_OFFSETS[i];
+            mean_px += cal_px[i];
+        }
+        mean_off /= NUM_CAL_POINTS;
+        mean_px /= NUM_CAL_POINTS;
+
+        float sxx = 0, sxy = 0, syy = 0;
+        for (int i = 0; i < NUM_CAL_POINTS; ++i) {
+            float dx = CAL_OFFSETS[i] - mean_off;
+            float dy = cal_px[i] - mean_px;
+            sxx += dx * dx;
+            sxy += dx * dy;
+            syy += dy * dy;
+        }
+        if (syy <= 0.0f)
+            return false;
+        float px_per_us = sxy / sxx;
+        float r2 = sxy * sxy / (sxx * syy);
+        int32_t ccr_per_px_q8 = static_cast<int32_t>(256.0f / (px_per_us < 0 ? -px_per_us : px_per_us) + 0.5f);
+        printf("Calibration %s: %.3f px/us, r2 %.3f\r\n", cal_axis == PAN ? "pan" : "tilt", px_per_us, r2);
+        if (r2 < 0.95f || ccr_per_px_q8 < CAL_MIN_CCR_PER_PX_Q8 || ccr_per_px_q8 > CAL_MAX_CCR_PER_PX_Q8)
+            return false;
+
+        // a longer pulse moving the target to larger pixels means the error sign is flipped
+        calibration.sign[cal_axis] = px_per_us > 0 ? -1 : 1;
+        calibration.ccr_per_px_q8[cal_axis] = ccr_per_px_q8;
         return true;
     }
 
-    // updates the smoothed values based on blk, updates CCR after finding values
-    void handle_block(const PixyBlock &blk) {
-        if (blk.sig == 1) {
-            smooth_x = alpha * blk.x + (1.0f - alpha) * smooth_x;
-            smooth_y = alpha * blk.y + (1.0f - alpha) * smooth_y;
+    // one camera tick of calibration, runs instead of the trackers
+    void calibration_step(uint32_t now) {
+        if (!is_tracking(now)) {
+            printf("Calibration stopped, target lost\r\n");
+            end_calibration();
+            return;
+        }
 
-            A_v = calculate_A_v(smooth_y, A_v);
-            A_h = calculate_A_h(smooth_x, A_h);
+        if (cal_state == CAL_SETTLE) {
+            if (++cal_ticks >= CAL_SETTLE_TICKS) {
+                cal_state = CAL_SAMPLE;
+                cal_ticks = 0;
+                cal_sum = 0;
+                cal_samples = 0;
+                cal_seq = target_seq;
+            }
+            return;
         }
 
-        __HAL_TIM_SET_COMPARE(servo_tim, TIM_CHANNEL_1, A_v);
-        __HAL_TIM_SET_COMPARE(servo_tim, TIM_CHANNEL_2, A_h);
+        if (target_seq != cal_seq) {
+            cal_seq = target_seq;
+            cal_sum += cal_axis == PAN ? target_x : target_y;
+            ++cal_samples;
+        }
+        if (++cal_ticks < CAL_SAMPLE_TICKS)
+            return;
+
+        if (cal_samples < CAL_MIN_SAMPLES) {
+            printf("Calibration stopped, too few blocks\r\n");
+            end_calibration();
+            return;
+        }
+        cal_px[cal_point] = static_cast<float>(cal_sum) / cal_samples;
+
+        if (++cal_point == NUM_CAL_POINTS) {
+            set_servo(cal_axis, cal_home[cal_axis]);
+            if (!fit_axis()) {
+                printf("Calibration failed, keeping the old mapping\r\n");
+                end_calibration();
+                return;
+            }
+            if (++cal_axis == NUM_AXES) {
+                set_calibration(calibration);
+                calibration_done = true;
+                end_calibration();
+                return;
+            }
+            cal_point = 0;
+        }
+        set_servo(cal_axis, cal_home[cal_axis] + CAL_OFFSETS[cal_point]);
+        cal_state = CAL_SETTLE;
+        cal_ticks = 0;
     }
 
-    // adds received bytes to frame_buf and converts frame_buf to PixyBlock when 20 have arrived
-    void process_bytes(uint8_t *data, uint16_t len) {
-        for (uint16_t i = 0; i < len; i++) {
-            uint8_t b = data[i];
-            frame_buf[frame_pos++] = b;
+    // walks the header state machine up to wr_pos, a block is parsed once all of its bytes are in
+    void process_bytes(uint16_t wr_pos) {
+        while (rd_pos != wr_pos) {
+            if (parse_state == PAYLOAD) {
+                if (((wr_pos - frame_start) & RX_MASK) < 2 + frame_len)
+                    return;
 
-            if (frame_pos >= 4) {
-                if (!(frame_buf[0] == 0xAF && frame_buf[1] == 0xC1 && frame_buf[2] == 0x21 && frame_buf[3] == 0x0E)) {
-                    memmove(frame_buf, frame_buf + 1, --frame_pos);
+                rd_pos = (frame_start + 2 + frame_len) & RX_MASK;
+                parse_state = SYNC0;
+                request_pending = false;
+                if (frame_type == TYPE_RESULT) {
+                    // no new frame yet, asking again right away would only get another BUSY, the next camera tick
+                    // sends the request instead
+                    handle_result(frame_start);
                     continue;
                 }
+                handle_frame(frame_start, frame_len);
+                ++frames;
+                // the answer is in, ask for the next one right away
+                request_pos();
+                continue;
             }
 
-            if (frame_pos == 20) {
-                PixyBlock p;
-                if (parse_one_block(frame_buf, &p))
-                    handle_block(p);
-
-                frame_pos = 0;
+            uint8_t b = dma_rx_buf[rd_pos];
+            rd_pos = (rd_pos + 1) & RX_MASK;
+            switch (parse_state) {
+            case SYNC0: parse_state = b == 0xAF ? SYNC1 : SYNC0; break;
+            case SYNC1: parse_state = b == 0xC1 ? TYPE : SYNC0; break;
+            case TYPE:
+                parse_state = b == TYPE_BLOCKS || b == TYPE_RESULT ? LENGTH : SYNC0;
+                frame_type = b;
+                break;
+            case LENGTH:
+                if (frame_type == TYPE_RESULT)
+                    parse_state = b == 4 ? PAYLOAD : SYNC0;
+                else
+                    parse_state = b % BLOCK_LENGTH == 0 && b <= MAX_BLOCKS * BLOCK_LENGTH ? PAYLOAD : SYNC0;
+                frame_len = b;
+                break;
+            default: break;
             }
+            // no header byte repeats, so a mismatch can only be the start of the next header
+            if (parse_state == SYNC0 && b == 0xAF)
+                parse_state = SYNC1;
+            if (parse_state == PAYLOAD)
+                frame_start = rd_pos;
         }
     }
 
+    void start_rx() {
+        parse_state = SYNC0;
+        rd_pos = 0;
+        // circular DMA that also reports the line going idle, so every response wakes the parser once
+        HAL_UARTEx_ReceiveToIdle_DMA(uart, dma_rx_buf, DMA_RX_BUFFER_SIZE);
+    }
+
 public:
     // default constructor for gimbal, init will actually construct the gimbal
     Gimbal() = default;
 
     // initializes the gimbal, need this instead of constructor so initialization happens after main.c even with globals
     void init(TIM_HandleTypeDef* servo_tim_in, TIM_HandleTypeDef* cam_tim_in, UART_HandleTypeDef* uart_in) {
-        servo_tim = servo_tim_in;
         cam_tim = cam_tim_in;
         uart = uart_in;
 
-        max_step = 10;
-        smooth_x = 157.5f;
-        smooth_y = 103.5f;
-        alpha = 0.5f;
-        A_v = 1500;
-        A_h = 1500;
+        // the frame is 316 x 208, the pulse per pixel comes from the lens angle and the servo travel
+        AxisTracker::Config pan_cfg = {315 << 7, -1, 171, 500, 2500, 10, 4 << 8, CAMERA_LATENCY_TICKS}; // center 157.5, 0.67us/px
+        AxisTracker::Config tilt_cfg = {207 << 7, 1, 124, 800, 2300, 10, 4 << 8, CAMERA_LATENCY_TICKS}; // center 103.5, 0.48us/px
+        uint32_t tick_ms = (cam_tim->Init.Prescaler + 1) * (cam_tim->Init.Period + 1) / (SystemCoreClock / 1000);
+        pan.init(pan_cfg, DEFAULT_GAINS, tick_ms, 1500);
+        tilt.init(tilt_cfg, DEFAULT_GAINS, tick_ms, 1500);
+        calibration = {CAL_MAGIC, {pan_cfg.sign, tilt_cfg.sign}, {pan_cfg.ccr_per_px_q8, tilt_cfg.ccr_per_px_q8}};
+        last_target_tick = HAL_GetTick() - TARGET_TIMEOUT_MS;
 
-        uint8_t cmd[6] = {0xAE, 0xC1, 0x20, 0x02, 0x01, 0xFF};
+        // getBlocks for TARGET_SIG, at most MAX_BLOCKS
+        uint8_t cmd[6] = {0xAE, 0xC1, 0x20, 0x02, TARGET_SIG, MAX_BLOCKS};
         memcpy(tx_buff, cmd, 6);
 
-        HAL_TIM_PWM_Start(servo_tim, TIM_CHANNEL_1);
-        HAL_TIM_PWM_Start(servo_tim, TIM_CHANNEL_2);
+        // 180 degrees over 500 - 2500us. the ramps spread each tracker step over a few periods, tighter limits
+        // make the servo lag the trackers, which assume a move is done by the next tick, and the loop hunts
+        servos.init(servo_tim_in, SERVO_PWM_HZ);
+        servo_idx[PAN] = servos.add({TIM_CHANNEL_2, 500, 2500, 180, 4000, 200000}, 1500);
+        servo_idx[TILT] = servos.add({TIM_CHANNEL_1, 500, 2500, 180, 4000, 200000}, 1500);
+        if (servo_idx[PAN] < 0 || servo_idx[TILT] < 0)
+            printf("Gimbal servo missing, that axis stays still\r\n");
+        servos.start();
         HAL_TIM_Base_Start_IT(cam_tim);
 
-        __HAL_TIM_SET_COMPARE(servo_tim, TIM_CHANNEL_1, A_v);
-        __HAL_TIM_SET_COMPARE(servo_tim, TIM_CHANNEL_2, A_h);
+        request_pending = false;
+        request_tick = HAL_GetTick();
+        policy = STICKY;
+        have_sticky = false;
+        sticky_idx = 0;
+        sticky_missed = 0;
+        target_seq = 0;
+        target_x = 0;
+        target_y = 0;
+        cal_state = CAL_IDLE;
+        calibration_done = false;
 
-        HAL_UART_Receive_DMA(uart, dma_rx_buf, DMA_RX_BUFFER_SIZE);
+        rx_events = 0;
+        frames = 0;
+        busy = 0;
+        blocks = 0;
+        parse_cycles = 0;
+        max_parse_cycles = 0;
+        stats_start = HAL_GetTick();
+        start_rx();
     }
 
-    // requests a pixy block from the pixy cam
-    void request_pos() {
-        HAL_UART_Transmit_IT(uart, tx_buff, sizeof(tx_buff));
+    // steps both axes, called by main driver on every camera tick so the loop runs at the TIM5 rate whether or
+    // not a block came in
+    void control_step(uint32_t now) {
+        if (cal_state != CAL_IDLE) {
+            calibration_step(now);
+            return;
+        }
+        if (!is_tracking(now)) {
+            pan.lose();
+            tilt.lose();
+            have_sticky = false;
+        }
+        set_servo(TILT, tilt.step());
+        set_servo(PAN, pan.step());
     }
 
-    // polls the dma buffer for any new bytes that have arrived
-    void poll_dma() {
-        uint16_t pos = DMA_RX_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(uart->hdmarx);
-
-        if (pos != dma_last_pos) {
-            if (pos > dma_last_pos) {
-                process_bytes(&dma_rx_buf[dma_last_pos], pos - dma_last_pos);
-            } else {
-                process_bytes(&dma_rx_buf[dma_last_pos], DMA_RX_BUFFER_SIZE - dma_last_pos);
-                process_bytes(&dma_rx_buf[0], pos);
-            }
+    // called from HAL_TIM_PeriodElapsedCallback on every servo PWM period
+    void handle_servo_tick() {
+        servos.handle_update();
+    }
 
-            dma_last_pos = pos;
+    // starts nudging the servos to measure the camera to servo mapping, needs a target in view that holds still
+    bool calibrate() {
+        if (cal_state != CAL_IDLE)
+            return false;
+        if (!is_tracking(HAL_GetTick())) {
+            printf("Calibration needs a target in view\r\n");
+            return false;
         }
+        printf("Calibrating, hold still\r\n");
+        calibration.magic = CAL_MAGIC;
+        cal_home[PAN] = pan.get_ccr();
+        cal_home[TILT] = tilt.get_ccr();
+        cal_axis = PAN;
+        cal_point = 0;
+        cal_ticks = 0;
+        cal_state = CAL_SETTLE;
+        set_servo(cal_axis, cal_home[cal_axis] + CAL_OFFSETS[cal_point]);
+        return true;
     }
 
-    // calculates new vertical CCR
-    uint16_t calculate_A_v(uint16_t y, uint16_t A_v) {
-        if (y > 108.5f || y < 98.5f) {
-            int16_t delta = (y - 103.5f) / 5.175f * (5.0f) / 2.0f;
-            if (delta > max_step) delta = max_step;
-            if (delta < -max_step) delta = -max_step;
+    bool is_calibrating() const {
+        return cal_state != CAL_IDLE;
+    }
+
+    // true once after a calibration finished, cal is what should be saved
+    bool take_calibration(Calibration* cal) {
+        if (!calibration_done)
+            return false;
+        calibration_done = false;
+        *cal = calibration;
+        return true;
+    }
 
-            A_v += delta;
-            if (A_v > 2300) A_v = 2300;
-            if (A_v < 800) A_v = 800;
+    // applies a saved or freshly measured mapping, false if it is not a calibration
+    bool set_calibration(Calibration const& cal) {
+        if (cal.magic != CAL_MAGIC)
+            return false;
+        for (uint8_t axis = 0; axis < NUM_AXES; ++axis) {
+            if ((cal.sign[axis] != 1 && cal.sign[axis] != -1) || cal.ccr_per_px_q8[axis] < CAL_MIN_CCR_PER_PX_Q8 ||
+                    cal.ccr_per_px_q8[axis] > CAL_MAX_CCR_PER_PX_Q8)
+                return false;
         }
-        return A_v;
+        for (uint8_t axis = 0; axis < NUM_AXES; ++axis)
+            axis_tracker(axis).set_geometry(cal.sign[axis], cal.ccr_per_px_q8[axis]);
+        calibration = cal;
+        return true;
+    }
+
+    void set_policy(TARGET_POLICY policy_in) {
+        policy = policy_in;
     }
 
-    // calculates new horizontal CCR
-    uint16_t calculate_A_h(uint16_t x, uint16_t A_h) {
-        if (x > 165 || x < 150) {
-            int16_t delta = (157.5f - x) / 5.25f * (7.0f) / 2.0f;
-            if (delta > max_step) delta = max_step;
-            if (delta < -max_step) delta = -max_step;
+    void set_gains(AXIS axis, AxisTracker::Gains const& gains) {
+        (axis == PAN ? pan : tilt).set_gains(gains);
+    }
 
-            A_h += delta;
-            if (A_h > 2500) A_h = 2500;
-            if (A_h < 500) A_h = 500;
+    AxisTracker::Metrics const& get_metrics(AXIS axis) const {
+        return (axis == PAN ? pan : tilt).get_metrics();
+    }
+
+    // requests a pixy block from the pixy cam
+    void request_pos() {
+        if (HAL_UART_Transmit_IT(uart, tx_buff, sizeof(tx_buff)) == HAL_OK) {
+            request_pending = true;
+            request_tick = HAL_GetTick();
         }
-        return A_h;
+    }
+
+    // block responses chain the next request themselves, called by main driver on every camera tick to ask again
+    // after a BUSY and to restart the chain if a request or its answer got lost
+    void check_request(uint32_t now) {
+        if (!request_pending || now - request_tick >= REQUEST_TIMEOUT_MS)
+            request_pos();
+    }
+
+    // called from HAL_UARTEx_RxEventCallback on IDLE, half and full
+    void handle_rx_event() {
+        ++rx_events;
+    }
+
+    // called by main driver after HAL_UART_ErrorCallback, HAL stops the DMA on a line error so it starts over from the
+    // top of the buffer. not from the callback itself, the parser state belongs to the task that runs process_rx
+    void restart_rx() {
+        HAL_UART_AbortReceive(uart);
+        start_rx();
+    }
+
+    // parses whatever the DMA has written since the last call, called by main driver after an rx event
+    void process_rx() {
+        uint32_t start = DWT->CYCCNT;
+        process_bytes((DMA_RX_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(uart->hdmarx)) & RX_MASK);
+        uint32_t cycles = DWT->CYCCNT - start;
+        parse_cycles += cycles;
+        if (cycles > max_parse_cycles) max_parse_cycles = cycles;
+    }
+
+    // prints rx wakeups and blocks per second and the parse cost per block since the last report
+    void report(uint32_t now) {
+        uint32_t ms = now - stats_start;
+        if (ms == 0)
+            return;
+        uint32_t cycles_per_us = SystemCoreClock / 1000000;
+        printf("pixy: %lu wakeups/s %lu frames/s %lu busy/s %lu blocks/s %lu cycles/block worst parse %luus\r\n",
+                rx_events * 1000 / ms, frames * 1000 / ms, busy * 1000 / ms, blocks * 1000 / ms,
+                blocks ? parse_cycles / blocks : 0, max_parse_cycles / cycles_per_us);
+        rx_events = 0;
+        frames = 0;
+        busy = 0;
+        blocks = 0;
+        parse_cycles = 0;
+        max_parse_cycles = 0;
+        stats_start = now;
+
+        AxisTracker::Metrics const& p = pan.get_metrics();
+        AxisTracker::Metrics const& t = tilt.get_metrics();
+        printf("pan: %lu moves settle %lums (worst %lu) overshoot %lupx (worst %lu)\r\n",
+                p.moves, p.settle_ms, p.worst_settle_ms, p.overshoot_px, p.worst_overshoot_px);
+        printf("tilt: %lu moves settle %lums (worst %lu) overshoot %lupx (worst %lu)\r\n",
+                t.moves, t.settle_ms, t.worst_settle_ms, t.overshoot_px, t.worst_overshoot_px);
+    }
+
+    // true while the camera keeps reporting the target
+    bool is_tracking(uint32_t now) {
+        return now - last_target_tick < TARGET_TIMEOUT_MS;
     }
 };
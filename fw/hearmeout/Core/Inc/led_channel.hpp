@@ -0,0 +1,261 @@
+/*
+ * Class for sending commands to the status LED FPGA over I2C without ever waiting on the bus
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdio>
+#include <cstring>
+
+class LedChannel {
+public:
+	// animations the FPGA runs on its own, each one scales the colour by an envelope
+	enum ANIMATION : uint8_t {
+		STATIC = 0x0,
+		BREATHE = 0x1, // fades in and out over 512 * (period + 1) ms
+		BLINK = 0x2, // same cycle as breathe
+		METER = 0x3 // follows the level up at once, falls back one step every period + 1 ms
+	};
+
+private:
+	// burst register map of the FPGA, the first byte of a write is the register to start at
+	enum REG : uint8_t {
+		R = 0x00,
+		G = 0x01,
+		B = 0x02,
+		MODE = 0x03,
+		LATCH = 0x04, // bit 0 applies R, G, B and MODE together
+		PERIOD = 0x05,
+		LEVEL = 0x06,
+		STATUS = 0x07, // read only, bits 2-0 are the lit channels, bits 7-4 the animation
+		ID = 0x08 // read only
+	};
+
+	static constexpr uint8_t FPGA_ID = 0x4C;
+
+	// each slot only keeps its newest command
+	static constexpr uint8_t STATE_SLOT = 0; // whole LED state
+	static constexpr uint8_t PERIOD_SLOT = 1;
+	static constexpr uint8_t LEVEL_SLOT = 2;
+	static constexpr int NUM_SLOTS = 8;
+	static constexpr int MAX_CMD_LEN = 8;
+	static constexpr int MAX_RETRIES = 3;
+	static constexpr int READ_IN_FLIGHT = NUM_SLOTS; // in_flight while the status read runs
+
+	struct command {
+		uint8_t bytes[MAX_CMD_LEN];
+		uint8_t len; // 0 if nothing is known about the slot
+		bool pending;
+		uint32_t seq; // order it was queued in, the oldest pending slot goes out first
+	};
+
+	I2C_HandleTypeDef* i2c;
+	uint16_t address; // already shifted for HAL
+	command slots[NUM_SLOTS]; // newest command per slot
+	command sent[NUM_SLOTS]; // last command the FPGA acked per slot
+	uint32_t next_seq;
+
+	// transfer in flight, owned by the interrupt while busy is set
+	volatile bool busy;
+	int in_flight;
+	uint8_t tx_buf[MAX_CMD_LEN];
+	uint8_t tx_len;
+	uint8_t retries;
+
+	// STATUS and ID are read back together, after every queued write has gone out
+	volatile bool read_requested;
+	volatile bool read_done;
+	uint8_t rx_buf[2];
+	uint8_t status;
+	bool id_checked;
+
+	volatile uint32_t errors;
+	uint32_t reported_errors;
+
+	static bool matches(command const& c, uint8_t const* bytes, uint8_t len){
+		return c.len == len && memcmp(c.bytes, bytes, len) == 0;
+	}
+
+	// starts the oldest pending command, called from the main loop with interrupts masked or from the I2C interrupt
+	void start_next(){
+		if(busy){
+			return;
+		}
+
+		int next = -1;
+		for(int i = 0; i < NUM_SLOTS; ++i){
+			if(slots[i].pending && (next < 0 || static_cast<int32_t>(slots[i].seq - slots[next].seq) < 0)){
+				next = i;
+			}
+		}
+		if(next < 0){
+			if(read_requested){
+				// writes the register pointer, then a repeated start reads STATUS and ID
+				read_requested = false;
+				in_flight = READ_IN_FLIGHT;
+				busy = true;
+				if(HAL_I2C_Mem_Read_IT(i2c, address, REG::STATUS, I2C_MEMADD_SIZE_8BIT, rx_buf, sizeof(rx_buf)) != HAL_OK){
+					busy = false;
+					read_requested = true;
+				}
+			}
+			return;
+		}
+
+		command& c = slots[next];
+		memcpy(tx_buf, c.bytes, c.len);
+		tx_len = c.len;
+		in_flight = next;
+		c.pending = false;
+		busy = true;
+		if(HAL_I2C_Master_Transmit_IT(i2c, address, tx_buf, tx_len) != HAL_OK){
+			// the peripheral is still busy or locked, service() tries again later
+			busy = false;
+			c.pending = true;
+		}
+	}
+
+public:
+	LedChannel() = default;
+
+	void init(I2C_HandleTypeDef* i2c_in, uint8_t address_in){
+		i2c = i2c_in;
+		address = address_in << 1;
+		for(int i = 0; i < NUM_SLOTS; ++i){
+			slots[i].len = 0;
+			slots[i].pending = false;
+			sent[i].len = 0;
+			sent[i].pending = false;
+		}
+		next_seq = 0;
+		busy = false;
+		in_flight = -1;
+		retries = 0;
+		read_requested = false;
+		read_done = false;
+		status = 0;
+		id_checked = false;
+		errors = 0;
+		reported_errors = 0;
+	}
+
+	// queues a command for a slot, a newer command replaces one still waiting there and commands that
+	// would not change what the FPGA already has are dropped, never waits on the bus
+	void queue(uint8_t slot, uint8_t const* bytes, uint8_t len){
+		if(slot >= NUM_SLOTS || len == 0 || len > MAX_CMD_LEN){
+			printf("Bad LED command\r\n");
+			return;
+		}
+
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+
+		command& c = slots[slot];
+		// what the FPGA will have once the bus is idle if nothing else is queued
+		bool same_as_current = (busy && in_flight == slot) ? (tx_len == len && memcmp(tx_buf, bytes, len) == 0) : matches(sent[slot], bytes, len);
+		if(same_as_current){
+			c.pending = false;
+		}else if(!c.pending || !matches(c, bytes, len)){
+			memcpy(c.bytes, bytes, len);
+			c.len = len;
+			if(!c.pending){
+				c.seq = next_seq++;
+				c.pending = true;
+			}
+		}
+
+		start_next();
+		__set_PRIMASK(primask);
+	}
+
+	// writes every channel and latches them in one transaction, red is status, green the SD card and blue AUX
+	void set_leds(uint8_t r, uint8_t g, uint8_t b, ANIMATION mode = ANIMATION::STATIC){
+		uint8_t cmd[] = {REG::R, r, g, b, mode, 0x1};
+		queue(STATE_SLOT, cmd, sizeof(cmd));
+	}
+
+	// animation speed in steps of 1 ms
+	void set_period(uint8_t period){
+		uint8_t cmd[] = {REG::PERIOD, period};
+		queue(PERIOD_SLOT, cmd, sizeof(cmd));
+	}
+
+	// input of the METER animation, updates faster than the bus can send collapse into the newest
+	void set_level(uint8_t level){
+		uint8_t cmd[] = {REG::LEVEL, level};
+		queue(LEVEL_SLOT, cmd, sizeof(cmd));
+	}
+
+	// reads STATUS and ID in the background, the ID is checked once by service()
+	void request_status(){
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		read_requested = true;
+		start_next();
+		__set_PRIMASK(primask);
+	}
+
+	// STATUS from the last finished read
+	uint8_t get_status() const {
+		return status;
+	}
+
+	// called from HAL_I2C_MemRxCpltCallback
+	void handle_rx_cb(){
+		status = rx_buf[0];
+		read_done = true;
+		busy = false;
+		start_next();
+	}
+
+	// called from HAL_I2C_MasterTxCpltCallback, chains straight into the next queued command
+	void handle_tx_cb(){
+		memcpy(sent[in_flight].bytes, tx_buf, tx_len);
+		sent[in_flight].len = tx_len;
+		retries = 0;
+		busy = false;
+		start_next();
+	}
+
+	// called from HAL_I2C_ErrorCallback, the command is retried unless a newer one replaced it
+	void handle_error_cb(){
+		++errors;
+		busy = false;
+		if(in_flight == READ_IN_FLIGHT){
+			start_next();
+			return;
+		}
+		sent[in_flight].len = 0;
+
+		command& c = slots[in_flight];
+		if(!c.pending && retries < MAX_RETRIES){
+			++retries;
+			memcpy(c.bytes, tx_buf, tx_len);
+			c.len = tx_len;
+			c.pending = true;
+		}else{
+			retries = 0;
+		}
+		start_next();
+	}
+
+	// restarts the queue if a transfer could not be started and reports bus errors, called by main driver
+	void service(){
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		start_next();
+		__set_PRIMASK(primask);
+
+		if(errors != reported_errors){
+			reported_errors = errors;
+			printf("LED I2C errors: %lu\r\n", reported_errors);
+		}
+
+		if(read_done && !id_checked){
+			id_checked = true;
+			if(rx_buf[1] != FPGA_ID){
+				printf("Unexpected LED FPGA id 0x%02X\r\n", rx_buf[1]);
+			}
+		}
+	}
+};
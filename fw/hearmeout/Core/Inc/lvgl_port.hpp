@@ -0,0 +1,195 @@
+/*
+ * Class for running the bundled LVGL as an alternative UI backend on the ILI9488/XPT2046
+ */
+#pragma once
+
+#include "main.h"
+#include "lvgl.h"
+#include "screen.hpp"
+#include "touch.hpp"
+#include "palette.hpp"
+
+class LvglPort {
+private:
+	// Screen Constants
+	static constexpr int SCREEN_WIDTH = 480;
+	static constexpr int SCREEN_HEIGHT = 320;
+	static constexpr int RGB666_SIZE = 3;
+
+	// Draw Buffer Variables
+	// LVGL renders 20 line bands into one buffer while the other one is being flushed, both buffers and the
+	// RGB666 staging buffer are statically allocated so they land in RAM3 with the rest of .bss
+	static constexpr int DRAW_BUF_LINES = 20;
+	static constexpr int DRAW_BUF_PIXELS = SCREEN_WIDTH * DRAW_BUF_LINES;
+	uint16_t draw_buf1[DRAW_BUF_PIXELS];
+	uint16_t draw_buf2[DRAW_BUF_PIXELS];
+	uint8_t dma_buf[DRAW_BUF_PIXELS * RGB666_SIZE]; // panel only accepts 18 bit color over SPI
+
+	lv_display_t* display;
+	lv_indev_t* touch;
+	Screen* screen;
+	Touch* touch_panel;
+	SPI_HandleTypeDef* display_spi;
+	volatile bool flush_busy; // set while SPI3 DMA is sending dma_buf
+	void (*service_audio)(); // keeps the audio refill running while LVGL waits on the display
+
+	// progress bar is updated from the audio refill path, so the value is only applied in handle()
+	lv_obj_t* progress_bar;
+	volatile int progress_pending;
+	int progress_shown;
+
+	// waits for the previous flush to leave dma_buf, servicing audio refills instead of spinning
+	void wait_flush(){
+		while(flush_busy){
+			service_audio();
+		}
+	}
+
+	static void flush_cb(lv_display_t* disp, lv_area_t const* area, uint8_t* px_map){
+		LvglPort* port = static_cast<LvglPort*>(lv_display_get_user_data(disp));
+		port->wait_flush();
+
+		uint16_t w = area->x2 - area->x1 + 1;
+		uint16_t h = area->y2 - area->y1 + 1;
+		uint32_t num_pixels = w * h;
+
+		// convert RGB565 into the RGB666 byte stream the panel expects
+		uint16_t const* src = reinterpret_cast<uint16_t const*>(px_map);
+		uint8_t* dst = port->dma_buf;
+		for(uint32_t i = 0; i < num_pixels; ++i){
+			uint16_t c = src[i];
+			dst[0] = (c >> 8) & 0xF8;
+			dst[1] = (c >> 3) & 0xFC;
+			dst[2] = (c << 3) & 0xF8;
+			dst += RGB666_SIZE;
+		}
+
+		// LVGL can start rendering into the other buffer as soon as this returns
+		port->flush_busy = true;
+		port->screen->begin_pixels(area->x1, area->y1, w, h);
+		if(HAL_SPI_Transmit_DMA(port->display_spi, port->dma_buf, num_pixels * RGB666_SIZE) != HAL_OK){
+			printf("Error starting LVGL flush DMA\r\n");
+			port->screen->end_pixels();
+			port->flush_busy = false;
+			lv_display_flush_ready(disp);
+		}
+	}
+
+	static void flush_wait_cb(lv_display_t* disp){
+		static_cast<LvglPort*>(lv_display_get_user_data(disp))->wait_flush();
+	}
+
+	static void touch_read_cb(lv_indev_t* indev, lv_indev_data_t* data){
+		LvglPort* port = static_cast<LvglPort*>(lv_indev_get_user_data(indev));
+
+		// Touch::service() keeps this up to date from the main loop, no SPI traffic here
+		TouchEvent const& last = port->touch_panel->get_last();
+		data->point.x = last.x;
+		data->point.y = last.y;
+		data->state = last.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+	}
+
+	static void button_event_cb(lv_event_t* e){
+		void (*callback)() = reinterpret_cast<void (*)()>(lv_event_get_user_data(e));
+		(*callback)();
+	}
+
+public:
+	LvglPort() = default;
+
+	// screen and touch must already be initialized, LVGL takes over the SPI3 window writes
+	void init(Screen* screen_in, Touch* touch_in, SPI_HandleTypeDef* display_spi_in, void (*service_audio_in)()){
+		printf("Initializing LVGL\r\n");
+
+		screen = screen_in;
+		touch_panel = touch_in;
+		display_spi = display_spi_in;
+		service_audio = service_audio_in;
+		flush_busy = false;
+		progress_bar = nullptr;
+
+		lv_init();
+
+		// the 1 ms HAL tick is already running off SysTick
+		lv_tick_set_cb(HAL_GetTick);
+
+		display = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+		lv_display_set_user_data(display, this);
+		lv_display_set_flush_cb(display, flush_cb);
+		lv_display_set_flush_wait_cb(display, flush_wait_cb);
+		lv_display_set_buffers(display, draw_buf1, draw_buf2, sizeof(draw_buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+		touch = lv_indev_create();
+		lv_indev_set_type(touch, LV_INDEV_TYPE_POINTER);
+		lv_indev_set_user_data(touch, this);
+		lv_indev_set_read_cb(touch, touch_read_cb);
+	}
+
+	// called from HAL_SPI_TxCpltCallback when the flush DMA finishes
+	void handle_dma_cb(){
+		screen->end_pixels();
+		flush_busy = false;
+		lv_display_flush_ready(display);
+	}
+
+	// runs LVGL timers, which only re-render invalidated areas, called by main driver
+	void handle(){
+		int progress = progress_pending;
+		if(progress_bar && progress != progress_shown){
+			lv_bar_set_value(progress_bar, progress, LV_ANIM_OFF);
+			progress_shown = progress;
+		}
+
+		lv_timer_handler();
+	}
+
+	// renders everything that is pending right away, needed before drawing outside of LVGL (e.g. album art)
+	void refresh(){
+		lv_refr_now(display);
+		wait_flush();
+	}
+
+	void clear(){
+		lv_obj_t* scr = lv_screen_active();
+		lv_obj_clean(scr);
+		progress_bar = nullptr;
+		lv_obj_set_style_bg_color(scr, lv_color_make(BACKGROUND_R, BACKGROUND_G, BACKGROUND_B), 0);
+	}
+
+	// same signature as Screen::draw_button() so the GUI layouts work on either backend
+	void draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h, void (*callback)(), char const* text){
+		lv_obj_t* btn = lv_button_create(lv_screen_active());
+		lv_obj_set_pos(btn, x, y);
+		lv_obj_set_size(btn, w, h);
+		lv_obj_set_style_radius(btn, 0, 0);
+		lv_obj_set_style_bg_color(btn, lv_color_make(UNPRESSED_BUTTON_R, UNPRESSED_BUTTON_G, UNPRESSED_BUTTON_B), 0);
+		lv_obj_set_style_bg_color(btn, lv_color_make(PRESSED_BUTTON_R, PRESSED_BUTTON_G, PRESSED_BUTTON_B), LV_STATE_PRESSED);
+		lv_obj_add_event_cb(btn, button_event_cb, LV_EVENT_CLICKED, reinterpret_cast<void*>(callback));
+
+		if(text){
+			lv_obj_t* label = lv_label_create(btn);
+			lv_label_set_text(label, text);
+			lv_obj_set_style_text_color(label, lv_color_make(FONT_R, FONT_G, FONT_B), 0);
+			lv_obj_center(label);
+		}
+	}
+
+	void draw_progress_bar(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+		progress_bar = lv_bar_create(lv_screen_active());
+		lv_obj_set_pos(progress_bar, x, y);
+		lv_obj_set_size(progress_bar, w, h);
+		lv_obj_set_style_radius(progress_bar, 0, LV_PART_MAIN);
+		lv_obj_set_style_radius(progress_bar, 0, LV_PART_INDICATOR);
+		lv_obj_set_style_bg_color(progress_bar, lv_color_make(PROGRESS_BAR_BACKGROUND_R, PROGRESS_BAR_BACKGROUND_G, PROGRESS_BAR_BACKGROUND_B), LV_PART_MAIN);
+		lv_obj_set_style_bg_opa(progress_bar, LV_OPA_COVER, LV_PART_MAIN);
+		lv_obj_set_style_bg_color(progress_bar, lv_color_make(PROGRESS_BAR_FOREGROUND_R, PROGRESS_BAR_FOREGROUND_G, PROGRESS_BAR_FOREGROUND_B), LV_PART_INDICATOR);
+		lv_bar_set_range(progress_bar, 0, w);
+		progress_pending = 0;
+		progress_shown = 0;
+	}
+
+	// safe to call from the audio refill path, the bar is redrawn on the next handle()
+	void set_progress(int pixels){
+		progress_pending = pixels;
+	}
+};
@@ -71,6 +71,11 @@ void HAL_DMA_XferCpltCallback(DMA_HandleTypeDef *hdma);
 #define T_CS_GPIO_Port GPIOD
 #define D_CS_Pin GPIO_PIN_2
 #define D_CS_GPIO_Port GPIOD
+#define A_CS_Pin GPIO_PIN_5
+#define A_CS_GPIO_Port GPIOD
+#define A_DRQ_Pin GPIO_PIN_6
+#define A_DRQ_GPIO_Port GPIOD
+#define A_DRQ_EXTI_IRQn EXTI9_5_IRQn
 
 /* USER CODE BEGIN Private defines */
 
@@ -0,0 +1,137 @@
+/*
+ * Class for scrolling a song title that is too long for its band using the ILI9488 hardware scroll
+ */
+#pragma once
+
+#include "main.h"
+#include <string>
+#include "screen.hpp"
+#include "palette.hpp"
+#include "font.hpp"
+
+class Marquee {
+private:
+	// Screen Constants
+	static constexpr int SCREEN_WIDTH = 480;
+	static constexpr int NUM_RGB = 3;
+
+	// Text Constants
+	static constexpr Font const& TITLE_FONT = FONT_LABEL;
+	static constexpr int TEXT_H = TITLE_FONT.line_h;
+	static constexpr int MAX_STRIP_W = 1024; // longest title in pixels, anything past it is cut off
+	static constexpr int GAP = 48; // blank space between the end of the title and its next repeat
+
+	// Scroll Constants
+	static constexpr uint32_t STEP_MS = 50;
+	static constexpr int STEP_PIXELS = 2;
+
+	Screen* screen;
+	uint16_t x;
+	uint16_t y;
+	uint16_t w;
+
+	// the title is rasterized once into one bit mask per column, bit n is row n
+	static_assert(TEXT_H <= 32, "title rows must fit in a strip column");
+	uint32_t strip[MAX_STRIP_W];
+	int text_w;
+	int period; // text_w + GAP, the virtual strip repeats with this length
+	uint32_t offset; // how many pixels the strip has scrolled so far
+	uint32_t last_step;
+	bool running;
+
+	uint8_t column[TEXT_H][NUM_RGB];
+
+	// fills column with virtual column v of the repeating title strip
+	void render_column(int v){
+		uint32_t bits = (v >= 0 && v < text_w) ? strip[v] : 0;
+
+		for(int row = 0; row < TEXT_H; ++row){
+			bool on = (bits >> row) & 0x1;
+			column[row][0] = on ? TITLE_R : BACKGROUND_R;
+			column[row][1] = on ? TITLE_G : BACKGROUND_G;
+			column[row][2] = on ? TITLE_B : BACKGROUND_B;
+		}
+	}
+
+	// writes virtual column v into memory line x + line
+	void draw_column(int line, int v){
+		render_column(v);
+		screen->draw_image_init(x + line, y, 1, TEXT_H);
+		screen->draw_image_row(&column[0][0], sizeof(column));
+	}
+
+public:
+	Marquee() = default;
+
+	// the band [x, x + w) is scrolled across the full screen height, so nothing else may be drawn inside it
+	void init(Screen* screen_in, uint16_t x_in, uint16_t y_in, uint16_t w_in){
+		screen = screen_in;
+		x = x_in;
+		y = y_in;
+		w = w_in;
+		running = false;
+	}
+
+	void start(std::string const& title){
+		// drop the drive prefix the sd paths carry (e.g. "0://")
+		size_t name_start = title.find_last_of('/');
+		name_start = (name_start == std::string::npos) ? 0 : name_start + 1;
+
+		char const* name = title.c_str() + name_start;
+
+		memset(strip, 0, sizeof(strip));
+		font_rasterize(TITLE_FONT, 0, 0, name, [&](int px, int py){
+			if(px >= 0 && px < MAX_STRIP_W && py >= 0 && py < TEXT_H){
+				strip[px] |= 1u << py;
+			}
+		});
+		text_w = std::min(font_text_width(TITLE_FONT, name), MAX_STRIP_W);
+		period = text_w + GAP;
+		offset = 0;
+		last_step = HAL_GetTick();
+
+		// clear the whole band, the scroll region shows every row of it
+		screen->reset_scroll();
+		screen->draw_box(x, 0, w, 320, BACKGROUND_R, BACKGROUND_G, BACKGROUND_B);
+
+		if(text_w <= w){
+			// fits, just center it and leave the hardware scroll off
+			running = false;
+			int pad = (w - text_w) / 2;
+			for(int i = 0; i < w; ++i){
+				draw_column(i, i - pad);
+			}
+			return;
+		}
+
+		for(int i = 0; i < w; ++i){
+			draw_column(i, i);
+		}
+
+		screen->define_scroll_area(x, w, SCREEN_WIDTH - x - w);
+		screen->set_scroll_start(x);
+		running = true;
+	}
+
+	void stop(){
+		running = false;
+		screen->reset_scroll();
+	}
+
+	// steps the scroll when it is due, only the columns that wrapped around are redrawn
+	void tick(uint32_t now){
+		if(!running || now - last_step < STEP_MS){
+			return;
+		}
+		last_step = now;
+
+		offset += STEP_PIXELS;
+		screen->set_scroll_start(x + (offset % w));
+
+		// the lines that just left the left edge reappear on the right, fill them with the next part of the strip
+		for(int i = 0; i < STEP_PIXELS; ++i){
+			uint32_t v = offset + w - STEP_PIXELS + i;
+			draw_column(v % w, v % period);
+		}
+	}
+};
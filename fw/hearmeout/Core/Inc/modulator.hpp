@@ -0,0 +1,248 @@
+/*
+ * Shapes the samples into the envelope of the ultrasonic carrier, after the EQ and before the output converts
+ * them. The air demodulates the carrier into roughly the second derivative of the envelope squared, so plain AM
+ * comes out with a strong second harmonic, the other modes pre-distort the envelope to undo that. In those the
+ * carrier the audio rides on follows the signal level, so quiet passages do not drive the transducers at full power
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdio>
+#include <cstdlib>
+
+class Modulator {
+public:
+	enum MODE : uint8_t {
+		LINEAR = 0x0, // plain double sideband AM, what the output always did
+		SQRT = 0x1, // envelope is the square root of the AM one, so its square has no harmonics
+		EQUALIZED = 0x2, // double integrates the audio first, so the second derivative in the air is flat too
+		NUM_MODES = 0x3
+	};
+
+	static constexpr uint16_t MAX_INDEX = 32768; // modulation index 1 in Q15
+	static constexpr int32_t MAX_CARRIER = 32768; // half the envelope range, the fixed carrier before tracking
+	// of the 3000 cycles per sample at 120MHz and 40kHz, next to the EQ's 150
+	static constexpr uint32_t BUDGET_CYCLES_PER_SAMPLE = 50;
+
+private:
+	// square root of 0 - 1 in 256 steps, Q16 clamped to 65535, interpolated between entries
+	static constexpr uint32_t SQRT_STEPS = 256;
+	uint16_t sqrt_table[SQRT_STEPS + 1];
+
+	// the double integration is two leaky integrators with poles at 1 - 2^-INTEGRATOR_SHIFT, about 400Hz, so
+	// they integrate across the audio band above the low cut without winding up on DC
+	static constexpr uint8_t INTEGRATOR_SHIFT = 4;
+	// 1kHz comes out of the two integrators 17dB down, this brings most of it back and saturates the rest
+	static constexpr uint8_t MAKEUP_SHIFT = 2;
+
+	// carrier tracking, only in the square root modes. their envelope squared is the carrier + m x, so the carrier
+	// drops out of the audio and only its slow changes demodulate. plain AM would come out scaled by the carrier
+	// and turn into an expander. the carrier is kept 25% above the modulation peak: it ramps up ahead of each peak
+	// in the buffer, holds for 50ms and then falls back over about 100ms. the hold keeps it from rippling with each
+	// cycle of the audio down to 20Hz, and the ramps and the fall are slow enough that nothing pumps
+	static constexpr uint32_t LOOKAHEAD_SAMPLES = 1024; // a whole output buffer, process() goes in pieces this big
+	static constexpr int32_t RAMP_STEP = MAX_CARRIER / 64; // per sample, up from the floor within 1.6ms
+	static constexpr uint8_t RELEASE_SHIFT = 12;
+	static constexpr uint32_t HOLD_SAMPLES = 2000;
+	static constexpr int32_t CARRIER_FLOOR = MAX_CARRIER / 32; // what is left during silence
+
+	MODE mode;
+	uint16_t index; // Q15
+
+	int32_t int1_q8;
+	int32_t int2_q8;
+
+	bool tracking;
+	int32_t carrier_q8;
+	uint32_t hold;
+	uint16_t need[LOOKAHEAD_SAMPLES]; // carrier each sample of the piece needs, with the ramps up to it
+
+	// drive power is the envelope squared, summed alongside what a fixed MAX_CARRIER would have needed
+	uint64_t power;
+	uint64_t fixed_power;
+
+	uint32_t samples;
+	uint32_t cycles;
+	uint32_t worst_cycles_per_sample;
+
+	static uint32_t isqrt(uint64_t v){
+		uint64_t r = 0;
+		for(uint64_t bit = 1ull << 62; bit; bit >>= 2){
+			if(v >= r + bit){
+				v -= r + bit;
+				r = (r >> 1) + bit;
+			}else{
+				r >>= 1;
+			}
+		}
+		return static_cast<uint32_t>(r);
+	}
+
+	static inline int32_t clamp(int32_t v, int32_t lo, int32_t hi){
+		return v < lo ? lo : (v > hi ? hi : v);
+	}
+
+	// Q16 envelope in, Q16 square root out
+	inline uint32_t sqrt_q16(uint32_t env) const {
+		uint32_t i = env >> 8;
+		int32_t lo = sqrt_table[i];
+		int32_t hi = sqrt_table[i + 1];
+		return static_cast<uint32_t>(lo + (((hi - lo) * static_cast<int32_t>(env & 0xFF)) >> 8));
+	}
+
+	// at most LOOKAHEAD_SAMPLES, m x goes in place first so the carrier can see the peaks coming
+	void process_piece(uint16_t* buf, uint32_t n){
+		bool track = tracking && mode != LINEAR;
+		for(uint32_t i = 0; i < n; ++i){
+			int32_t x = static_cast<int16_t>(buf[i]);
+			if(mode == EQUALIZED){
+				int1_q8 += ((x << 8) - int1_q8) >> INTEGRATOR_SHIFT;
+				int2_q8 += (int1_q8 - int2_q8) >> INTEGRATOR_SHIFT;
+				x = clamp((int2_q8 >> 8) << MAKEUP_SHIFT, INT16_MIN, INT16_MAX);
+			}
+			int32_t mx = (x * index) >> 15;
+			buf[i] = static_cast<uint16_t>(mx);
+			if(track){
+				int32_t peak = abs(mx);
+				need[i] = static_cast<uint16_t>(clamp(peak + (peak >> 2), CARRIER_FLOOR, MAX_CARRIER));
+			}
+		}
+
+		// backwards, so each need starts ramping up RAMP_STEP a sample before the peak it is for
+		if(track){
+			for(uint32_t i = n - 1; i > 0; --i){
+				int32_t ramp = need[i] - RAMP_STEP;
+				if(ramp > need[i - 1]){
+					need[i - 1] = static_cast<uint16_t>(ramp);
+				}
+			}
+		}
+
+		for(uint32_t i = 0; i < n; ++i){
+			int32_t mx = static_cast<int16_t>(buf[i]);
+			int32_t carrier = MAX_CARRIER;
+			if(track){
+				// a peak near the start of the piece has no room to ramp, the carrier steps instead of clipping
+				int32_t target = need[i] << 8;
+				if(target >= carrier_q8){
+					carrier_q8 = target;
+					hold = HOLD_SAMPLES;
+				}else if(hold){
+					--hold;
+				}else{
+					carrier_q8 -= (carrier_q8 - target) >> RELEASE_SHIFT;
+				}
+				carrier = carrier_q8 >> 8;
+			}
+			// carrier + m x as Q16, (1 + m x) / 2 with the fixed carrier
+			uint32_t u = clamp(carrier + mx, 0, 65535);
+			uint32_t u_fixed = clamp(MAX_CARRIER + mx, 0, 65535);
+			uint32_t env = u;
+			if(mode == LINEAR){
+				power += u * u;
+				fixed_power += u_fixed * u_fixed;
+			}else{
+				// the square root's square is the carrier + m x it was taken of
+				env = sqrt_q16(u);
+				env = env > 65535 ? 65535 : env;
+				power += u << 16;
+				fixed_power += u_fixed << 16;
+			}
+			buf[i] = static_cast<uint16_t>(static_cast<int32_t>(env) - 32768);
+		}
+	}
+
+public:
+	Modulator() = default;
+
+	void init(){
+		for(uint32_t i = 0; i <= SQRT_STEPS; ++i){
+			uint32_t s = isqrt(static_cast<uint64_t>(i) << 24);
+			sqrt_table[i] = static_cast<uint16_t>(s > 0xFFFF ? 0xFFFF : s);
+		}
+		mode = LINEAR;
+		index = MAX_INDEX;
+		tracking = true;
+		carrier_q8 = MAX_CARRIER << 8;
+		hold = 0;
+		power = 0;
+		fixed_power = 0;
+		samples = 0;
+		cycles = 0;
+		worst_cycles_per_sample = 0;
+		reset();
+	}
+
+	void reset(){
+		int1_q8 = 0;
+		int2_q8 = 0;
+	}
+
+	// only from the main loop, process() runs there too
+	void set_mode(MODE m){
+		if(m >= NUM_MODES)
+			return;
+		mode = m;
+		reset();
+		// tracking starts over from the top, a carrier below the signal would clip it
+		carrier_q8 = MAX_CARRIER << 8;
+		hold = 0;
+		printf("AM %s\r\n", mode == LINEAR ? "linear" : (mode == SQRT ? "square root" : "equalized"));
+	}
+
+	void next_mode(){
+		set_mode(static_cast<MODE>((mode + 1) % NUM_MODES));
+	}
+
+	// Q15, 0 is a bare carrier and MAX_INDEX swings the envelope all the way to 0
+	void set_index(uint16_t index_in){
+		index = index_in > MAX_INDEX ? MAX_INDEX : index_in;
+		printf("AM index %lu%%\r\n", static_cast<uint32_t>(index) * 100 / MAX_INDEX);
+	}
+
+	// steps down a quarter at a time and wraps back to full
+	void next_index(){
+		set_index(index <= MAX_INDEX / 4 ? MAX_INDEX : index - MAX_INDEX / 4);
+	}
+
+	// off puts the carrier back at MAX_CARRIER all the time, LINEAR always has it there
+	void set_tracking(bool tracking_in){
+		tracking = tracking_in;
+		carrier_q8 = MAX_CARRIER << 8;
+		hold = 0;
+	}
+
+	// 16 bit signed samples in, the envelope in the same format out, -32768 is the carrier off and 32767 full on
+	void process(uint16_t* buf, uint32_t n){
+		uint32_t start = DWT->CYCCNT;
+		for(uint32_t i = 0; i < n; i += LOOKAHEAD_SAMPLES){
+			process_piece(buf + i, n - i < LOOKAHEAD_SAMPLES ? n - i : LOOKAHEAD_SAMPLES);
+		}
+
+		uint32_t elapsed = DWT->CYCCNT - start;
+		cycles += elapsed;
+		samples += n;
+		if(n && elapsed / n > worst_cycles_per_sample){
+			worst_cycles_per_sample = elapsed / n;
+		}
+	}
+
+	// average and worst cycles per sample since the last report, flagged when over budget, and the average drive
+	// power of the source as a share of a full on carrier and of what the fixed carrier would have used
+	void report(char const* source){
+		if(samples == 0)
+			return;
+		printf("am: %lu cycles/sample worst %lu%s\r\n", cycles / samples, worst_cycles_per_sample,
+				worst_cycles_per_sample > BUDGET_CYCLES_PER_SAMPLE ? " over budget" : "");
+		uint64_t full_power = static_cast<uint64_t>(samples) * 65535 * 65535;
+		printf("carrier %s: %s drive %lu%% of full, %lu%% of fixed\r\n", source,
+				tracking && mode != LINEAR ? "tracking" : "fixed",
+				static_cast<uint32_t>(power * 100 / full_power),
+				static_cast<uint32_t>(fixed_power ? power * 100 / fixed_power : 0));
+		samples = 0;
+		cycles = 0;
+		worst_cycles_per_sample = 0;
+		power = 0;
+		fixed_power = 0;
+	}
+};
@@ -29,3 +29,19 @@ static constexpr uint8_t BACKGROUND_R = 15;
 static constexpr uint8_t BACKGROUND_G = 15;
 static constexpr uint8_t BACKGROUND_B = 15;
 // SCREEN //
+
+// TITLE //
+static constexpr uint8_t TITLE_R = 255;
+static constexpr uint8_t TITLE_G = 255;
+static constexpr uint8_t TITLE_B = 255;
+// TITLE //
+
+// TRACKING //
+static constexpr uint8_t TRACKING_ON_R = 40;
+static constexpr uint8_t TRACKING_ON_G = 200;
+static constexpr uint8_t TRACKING_ON_B = 80;
+
+static constexpr uint8_t TRACKING_OFF_R = 60;
+static constexpr uint8_t TRACKING_OFF_G = 60;
+static constexpr uint8_t TRACKING_OFF_B = 60;
+// TRACKING //
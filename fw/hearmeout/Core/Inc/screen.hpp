@@ -25,7 +25,10 @@ enum SCREEN_CMD : uint8_t {
 	IFMODE = 0xB0,
 	FRMCTR1 = 0xB1,
 	SLPOUT = 0x11,
+	NORON = 0x13,
 	DISON = 0x29,
+	VSCRDEF = 0x33,
+	VSCRSADD = 0x37,
 	INVTR = 0xB4,
 	DISCTRL = 0xB6,
 	SETIMAGE = 0xE9,
@@ -37,8 +40,6 @@ private:
 
 	// Communication Variables
 	SPI_HandleTypeDef* display_spi;
-	SPI_HandleTypeDef* touch_spi;
-	TIM_HandleTypeDef* touch_timer_poll;
 	static constexpr int TEMP_BUFFER_SIZE = 256;
 	static constexpr int NUM_RGB = 3;
 	uint8_t temp[TEMP_BUFFER_SIZE][NUM_RGB];
@@ -63,13 +64,25 @@ private:
 		BUTTON_STATE button_state;
 		char const* text;
 		void (*callback)();
+		int sprite_offset; // offset of the button's text mask in sprite_cache, -1 if not cached
 	};
 
-	static constexpr int NUM_BUTTONS = 5;
+	static constexpr int NUM_BUTTONS = 8; // the jack GUI, five down the sides and the three audio settings
 
 	int num_buttons;
 	button buttons[NUM_BUTTONS];
 
+	// Sprite Cache Variables
+	// each button's text is rasterized once into a 1 bit per pixel mask when draw_button() is called,
+	// the pressed and unpressed appearances are both expanded from it so a state change is one window + blit.
+	// full RGB666 sprites of both states would need ~108KB per 200x90 button, more than RAM3 can spare
+	static constexpr int SPRITE_CACHE_SIZE = 16 * 1024;
+	uint8_t sprite_cache[SPRITE_CACHE_SIZE];
+	int sprite_cache_used;
+
+	// Scroll Variables
+	bool scrolling; // true while the controller is in vertical scroll mode
+
 	// Private Member Functions
 
 	void cs_low(){
@@ -136,7 +149,57 @@ private:
 
 	}
 
+	// sets the window that the next RAMWR will fill
+	void set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+		uint8_t caset[] = {static_cast<uint8_t>((x >> 8) & 0xFF), static_cast<uint8_t>(x & 0xFF), static_cast<uint8_t>(((x + w - 1) >> 8) & 0xFF), static_cast<uint8_t>((x + w - 1) & 0xFF)};
+		send_cmd(SCREEN_CMD::CASET);
+		send_data(caset, sizeof(caset));
+
+		uint8_t paset[] = {static_cast<uint8_t>((y >> 8) & 0xFF), static_cast<uint8_t>(y & 0xFF), static_cast<uint8_t>(((y + h - 1) >> 8) & 0xFF), static_cast<uint8_t>((y + h - 1) & 0xFF)};
+		send_cmd(SCREEN_CMD::PASET);
+		send_data(paset, sizeof(paset));
+	}
+
+	// rasterizes the button text into a mask in the sprite cache, only called when the layout or text changes
+	void render_sprite(uint16_t index){
+		button& btn = buttons[index];
+		int mask_size = (btn.w * btn.h + 7) / 8;
+
+		if(sprite_cache_used + mask_size > SPRITE_CACHE_SIZE){
+			printf("Sprite cache full\r\n");
+			btn.sprite_offset = -1;
+			return;
+		}
+
+		btn.sprite_offset = sprite_cache_used;
+		sprite_cache_used += mask_size;
+
+		uint8_t* mask = &sprite_cache[btn.sprite_offset];
+		memset(mask, 0, mask_size);
+
+		if(!btn.text){
+			return;
+		}
+
+		// same placement as the uncached path in render_button(), relative to the button origin
+		int base_x = (btn.w - font_text_width(FONT_LABEL, btn.text)) / 2;
+		int base_y = (btn.h - FONT_LABEL.line_h) / 2;
+
+		font_rasterize(FONT_LABEL, base_x, base_y, btn.text, [&](int px, int py){
+			if(px < 0 || px >= btn.w || py < 0 || py >= btn.h){
+				return;
+			}
+			int bit = py * btn.w + px;
+			mask[bit >> 3] |= 0x80 >> (bit & 0x7);
+		});
+	}
+
 	void render_button(uint16_t index){
+		if(buttons[index].sprite_offset >= 0){
+			blit_button(index);
+			return;
+		}
+
 		// draw the button on the screen
 		uint8_t caset[] = {static_cast<uint8_t>((buttons[index].x >> 8) & 0xFF), static_cast<uint8_t>(buttons[index].x & 0xFF), static_cast<uint8_t>(((buttons[index].x + buttons[index].w - 1) >> 8) & 0xFF), static_cast<uint8_t>((buttons[index].x + buttons[index].w - 1) & 0xFF)};
 		send_cmd(SCREEN_CMD::CASET);
@@ -150,17 +213,18 @@ private:
 		uint8_t button_rgb[NUM_RGB];
 
 		if(buttons[index].button_state == BUTTON_STATE::UNPRESSED){
-			for(int i = 0; i < TEMP_BUFFER_SIZE; ++i){
-				temp[i][0] = UNPRESSED_BUTTON_R;
-				temp[i][1] = UNPRESSED_BUTTON_G;
-				temp[i][2] = UNPRESSED_BUTTON_B;
-			}
+			button_rgb[0] = UNPRESSED_BUTTON_R;
+			button_rgb[1] = UNPRESSED_BUTTON_G;
+			button_rgb[2] = UNPRESSED_BUTTON_B;
 		}else{
-			for(int i = 0; i < TEMP_BUFFER_SIZE; ++i){
-				temp[i][0] = PRESSED_BUTTON_R;
-				temp[i][1] = PRESSED_BUTTON_G;
-				temp[i][2] = PRESSED_BUTTON_B;
-			}
+			button_rgb[0] = PRESSED_BUTTON_R;
+			button_rgb[1] = PRESSED_BUTTON_G;
+			button_rgb[2] = PRESSED_BUTTON_B;
+		}
+		for(int i = 0; i < TEMP_BUFFER_SIZE; ++i){
+			temp[i][0] = button_rgb[0];
+			temp[i][1] = button_rgb[1];
+			temp[i][2] = button_rgb[2];
 		}
 
 		send_cmd(SCREEN_CMD::RAMWR);
@@ -171,8 +235,43 @@ private:
 
 		// draw text
 		if(buttons[index].text){
-			int len = strlen(buttons[index].text);
-			draw_string(buttons[index].x + (buttons[index].w / 2) - (len * (FONT_WIDTH + FONT_SPACING) * FONT_SIZE) / 2, buttons[index].y + (buttons[index].h / 2) - (FONT_HEIGHT * FONT_SIZE) / 2, buttons[index].text);
+			uint8_t const font_rgb[NUM_RGB] = {FONT_R, FONT_G, FONT_B};
+			int text_w = font_text_width(FONT_LABEL, buttons[index].text);
+			draw_text(buttons[index].x + (buttons[index].w - text_w) / 2, buttons[index].y + (buttons[index].h - FONT_LABEL.line_h) / 2, buttons[index].text, FONT_LABEL, font_rgb, button_rgb);
+		}
+	}
+
+	// draws a cached button as a single window, expanding the mask into the current state's colors
+	void blit_button(uint16_t index){
+		button const& btn = buttons[index];
+		uint8_t const* mask = &sprite_cache[btn.sprite_offset];
+
+		uint8_t bg_rgb[NUM_RGB];
+		if(btn.button_state == BUTTON_STATE::UNPRESSED){
+			bg_rgb[0] = UNPRESSED_BUTTON_R;
+			bg_rgb[1] = UNPRESSED_BUTTON_G;
+			bg_rgb[2] = UNPRESSED_BUTTON_B;
+		}else{
+			bg_rgb[0] = PRESSED_BUTTON_R;
+			bg_rgb[1] = PRESSED_BUTTON_G;
+			bg_rgb[2] = PRESSED_BUTTON_B;
+		}
+		uint8_t const font_rgb[NUM_RGB] = {FONT_R, FONT_G, FONT_B};
+
+		set_window(btn.x, btn.y, btn.w, btn.h);
+		send_cmd(SCREEN_CMD::RAMWR);
+
+		unsigned int num_pixels = btn.w * btn.h;
+		for(unsigned int base = 0; base < num_pixels; base += TEMP_BUFFER_SIZE){
+			unsigned int count = std::min(static_cast<unsigned int>(TEMP_BUFFER_SIZE), num_pixels - base);
+			for(unsigned int i = 0; i < count; ++i){
+				unsigned int bit = base + i;
+				uint8_t const* rgb = (mask[bit >> 3] & (0x80 >> (bit & 0x7))) ? font_rgb : bg_rgb;
+				temp[i][0] = rgb[0];
+				temp[i][1] = rgb[1];
+				temp[i][2] = rgb[2];
+			}
+			send_data(&temp[0][0], count * NUM_RGB);
 		}
 	}
 
@@ -205,22 +304,57 @@ public:
 		}
 	}
 
+	// defines the hardware scroll area along the controller's 480 gate lines (the x axis with our MADCTL),
+	// tfa + vsa + bfa must add up to SCREEN_WIDTH
+	void define_scroll_area(uint16_t tfa, uint16_t vsa, uint16_t bfa){
+		uint8_t vscrdef[] = {
+				static_cast<uint8_t>((tfa >> 8) & 0xFF), static_cast<uint8_t>(tfa & 0xFF),
+				static_cast<uint8_t>((vsa >> 8) & 0xFF), static_cast<uint8_t>(vsa & 0xFF),
+				static_cast<uint8_t>((bfa >> 8) & 0xFF), static_cast<uint8_t>(bfa & 0xFF)
+		};
+		send_cmd(SCREEN_CMD::VSCRDEF);
+		send_data(vscrdef, sizeof(vscrdef));
+	}
+
+	// sets which memory line is shown first in the scroll area, this enters scroll mode
+	void set_scroll_start(uint16_t line){
+		uint8_t vscrsadd[] = {static_cast<uint8_t>((line >> 8) & 0xFF), static_cast<uint8_t>(line & 0xFF)};
+		send_cmd(SCREEN_CMD::VSCRSADD);
+		send_data(vscrsadd, sizeof(vscrsadd));
+		scrolling = true;
+	}
+
+	// leaves scroll mode so memory maps straight onto the screen again
+	void reset_scroll(){
+		if(scrolling){
+			send_cmd(SCREEN_CMD::NORON);
+			scrolling = false;
+		}
+	}
+
 	void clear(){
+		// any scrolled region would shift the new layout, so go back to normal mode first
+		reset_scroll();
+
 		// clear the screen to the background color
 		draw_box(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, BACKGROUND_R, BACKGROUND_G, BACKGROUND_B);
 
 		num_buttons = 0;
 		for(int i = 0; i < NUM_BUTTONS; ++i){
 			buttons[i].valid = false;
+			buttons[i].sprite_offset = -1;
 		}
+
+		// the layout is being rebuilt so every cached sprite is stale
+		sprite_cache_used = 0;
 	}
 
-	void init (SPI_HandleTypeDef* display_spi_in, SPI_HandleTypeDef* touch_spi_in, TIM_HandleTypeDef* touch_timer_poll_in) {
+	void init (SPI_HandleTypeDef* display_spi_in) {
 		printf("Initializing Screen\r\n");
 
 		// get the spi device we will talk over
 		display_spi = display_spi_in;
-		touch_spi = touch_spi_in;
+		scrolling = false;
 
 		cs_high();
 		rst_low();
@@ -324,10 +458,6 @@ public:
 		HAL_Delay(150);
 
 		send_cmd(SCREEN_CMD::DISON);
-
-		// the timer we are going to use to poll the screen
-		touch_timer_poll = touch_timer_poll_in;
-		HAL_TIM_Base_Start_IT(touch_timer_poll);
 	}
 
 	void draw_button(uint16_t x, uint16_t y, uint16_t w, uint16_t h, void (*callback)(), char const* text){
@@ -347,6 +477,8 @@ public:
 		buttons[num_buttons].text = text;
 		buttons[num_buttons].callback = callback;
 
+		// pre-render the sprite once here so presses in check_buttons() are a single blit
+		render_sprite(num_buttons);
 		render_button(num_buttons);
 
 		++num_buttons;
@@ -383,121 +515,69 @@ public:
 		}
 	}
 
-	void draw_string(uint16_t base_x, uint16_t base_y, char const* str){
-		int str_len = strlen(str);
-		// loop through all of the characters in the string
-		for(int idx = 0; idx < str_len; ++idx){
-
-			if(str[idx] != ' '){
-				uint8_t* char_ptr = &font[(str[idx] - 'A') * FONT_HEIGHT];
-
-				// loop through all of the rows in a character
-				for(int row = 0; row < FONT_HEIGHT; ++row){
-					uint8_t row_data = char_ptr[row];
-					for(int col = 0; col < FONT_WIDTH; ++col){
-						// if there is a pixel to draw, draw it
-						if((row_data & 0x80) == 0x80){
-							// draw the button on the screen
-							uint16_t px = base_x + FONT_SIZE * col;
-							uint8_t caset[] = {static_cast<uint8_t>((px >> 8) & 0xFF), static_cast<uint8_t>(px & 0xFF), static_cast<uint8_t>(((px + FONT_SIZE - 1) >> 8) & 0xFF), static_cast<uint8_t>((px + FONT_SIZE - 1) & 0xFF)};
-							send_cmd(SCREEN_CMD::CASET);
-							send_data(caset, sizeof(caset));
-
-							uint16_t py = base_y + FONT_SIZE * row;
-							uint8_t paset[] = {static_cast<uint8_t>((py >> 8) & 0xFF), static_cast<uint8_t>(py & 0xFF), static_cast<uint8_t>(((py + FONT_SIZE - 1) >> 8) & 0xFF), static_cast<uint8_t>((py + FONT_SIZE - 1) & 0xFF)};
-							send_cmd(SCREEN_CMD::PASET);
-							send_data(paset, sizeof(paset));
-
-							unsigned int num_pixels = FONT_SIZE * FONT_SIZE;
-							uint8_t font_rgb[] = {FONT_R, FONT_G, FONT_B};
-							send_cmd(SCREEN_CMD::RAMWR);
-
-							for(unsigned int i = 0; i < num_pixels; ++i){
-								send_data(font_rgb, sizeof(font_rgb));
-							}
-						}
+	// draws str with its line top left at (x, y), every glyph cell (advance x line height) is one window that
+	// is streamed row by row, so the background is filled in as well and no per pixel windows are needed.
+	// returns the x just past the last glyph
+	uint16_t draw_text(uint16_t x, uint16_t y, char const* str, Font const& font, uint8_t const fg[NUM_RGB], uint8_t const bg[NUM_RGB]){
+		for(int idx = 0; str[idx]; ++idx){
+			Glyph const* glyph = font_find(font, str[idx]);
+			int cell_w = font_advance(font, str[idx], str[idx + 1]);
+			if(cell_w <= 0 || x + cell_w > SCREEN_WIDTH){
+				x += std::max(cell_w, 0);
+				continue;
+			}
+
+			set_window(x, y, cell_w, font.line_h);
+			send_cmd(SCREEN_CMD::RAMWR);
+
+			GlyphReader reader(font, glyph);
+			int count = 0;
+			for(int row = 0; row < font.line_h; ++row){
+				// flush whole rows so a row never straddles two sends
+				if(count + cell_w > TEMP_BUFFER_SIZE){
+					send_data(&temp[0][0], count * NUM_RGB);
+					count = 0;
+				}
+
+				uint8_t (*line)[NUM_RGB] = &temp[count];
+				for(int col = 0; col < cell_w; ++col){
+					line[col][0] = bg[0];
+					line[col][1] = bg[1];
+					line[col][2] = bg[2];
+				}
 
-						// shift to get the next pixel in the font
-						row_data <<= 1;
+				int glyph_row = row - glyph->y_off;
+				if(glyph_row >= 0 && glyph_row < glyph->h){
+					// bits are read even when they fall outside the cell to keep the RLE stream in step
+					for(int col = 0; col < glyph->w; ++col){
+						int cx = glyph->x_off + col;
+						if(reader.next() && cx >= 0 && cx < cell_w){
+							line[cx][0] = fg[0];
+							line[cx][1] = fg[1];
+							line[cx][2] = fg[2];
+						}
 					}
 				}
+				count += cell_w;
 			}
-			base_x += FONT_SIZE * (FONT_WIDTH + FONT_SPACING);
+			send_data(&temp[0][0], count * NUM_RGB);
+
+			x += cell_w;
 		}
+		return x;
 	}
 
-	void sample_x_y(uint16_t* x_in, uint16_t* y_in, uint16_t* z_in){
-		// commands to sample x and y
-		static constexpr uint8_t sample_x = 0x94;
-		static constexpr uint8_t sample_y = 0xD4;
-		static constexpr uint8_t sample_z = 0xB4;
-
-		// adc values from calibration on 20-11-2025
-		static uint16_t short_axis_min = 180;
-		static uint16_t short_axis_max = 1900;
-		static uint16_t long_axis_min = 180;
-		static uint16_t long_axis_max = 2000;
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_RESET); // select the touchscreen chip
-
-		// send the command to read the x touch location
-		uint8_t buf[2];
-		HAL_SPI_Transmit(touch_spi, &sample_x, sizeof(sample_x), HAL_MAX_DELAY);
-		HAL_SPI_Receive(touch_spi, buf, sizeof(buf), HAL_MAX_DELAY);
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_SET); // unselect the touchscreen chip
-
-		*x_in = ((buf[0] << 8) + buf[1]) >> 4;
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_RESET); // select the touchscreen chip
-
-		// send the command to read the y touch location
-		HAL_SPI_Transmit(touch_spi, &sample_y, sizeof(sample_y), HAL_MAX_DELAY);
-		HAL_SPI_Receive(touch_spi, buf, sizeof(buf), HAL_MAX_DELAY);
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_SET); // unselect the touchscreen chip
-
-		*y_in = ((buf[0] << 8) + buf[1]) >> 4;
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_RESET); // select the touchscreen chip
-
-		// send the command to read the z touch location
-		HAL_SPI_Transmit(touch_spi, &sample_z, sizeof(sample_z), HAL_MAX_DELAY);
-		HAL_SPI_Receive(touch_spi, buf, sizeof(buf), HAL_MAX_DELAY);
-		*z_in = ((buf[0] << 8) + buf[1]) >> 4;
-
-		HAL_GPIO_WritePin(GPIOD, GPIO_PIN_0, GPIO_PIN_SET); // unselect the touchscreen chip
-
-		uint16_t shortAxisScaled = ((float) (*x_in - long_axis_min) / (float) (long_axis_max - long_axis_min) * (float) SCREEN_WIDTH);
-		uint16_t longAxisScaled = ((float) (*y_in - short_axis_min) / (float) (short_axis_max - short_axis_min) * (float) SCREEN_HEIGHT);
-
-		// clamp axis values to be in valid range
-		shortAxisScaled = std::max(static_cast<uint16_t>(0), shortAxisScaled);
-		shortAxisScaled = std::min(shortAxisScaled, static_cast<uint16_t>(SCREEN_WIDTH));
-		longAxisScaled = std::max(static_cast<uint16_t>(0), longAxisScaled);
-		longAxisScaled = std::min(longAxisScaled, static_cast<uint16_t>(SCREEN_HEIGHT));
-
-		// convert the touch coords to screen coords
-		static constexpr int orientation = 0;
-		switch (orientation) {
-		case 0:
-			*x_in = shortAxisScaled;
-			*y_in = longAxisScaled;
-			break;
-		case 1:
-			*x_in = longAxisScaled;
-			*y_in = shortAxisScaled;
-			break;
-		case 2:
-			*x_in = SCREEN_HEIGHT - shortAxisScaled;
-			*y_in = SCREEN_WIDTH - longAxisScaled;
-			break;
-		case 3:
-			*x_in = SCREEN_WIDTH - longAxisScaled;
-			*y_in = SCREEN_HEIGHT - shortAxisScaled;
-			break;
-		}
+	// opens a window and leaves the display selected so the caller can stream pixels itself (e.g. over DMA)
+	void begin_pixels(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+		set_window(x, y, w, h);
+		send_cmd(SCREEN_CMD::RAMWR);
+		dc_high();
+		cs_low();
+	}
 
+	// deselects the display after a begin_pixels() stream completes
+	void end_pixels(){
+		cs_high();
 	}
 
 	void draw_image_init(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
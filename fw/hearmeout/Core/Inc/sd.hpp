@@ -8,14 +8,13 @@
 #include "ff.h"
 #include "ffconf.h"
 #include "screen.hpp"
+#include "audio_out.hpp"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <vector>
 #include <string>
 
-#define BUFFER_SIZE 1024
-
 typedef struct {
     uint8_t r;
     uint8_t g;
@@ -40,16 +39,9 @@ private:
 	FATFS fs; // FATFS filesystem object
 	char sd_path[4]; // char array for storing sd path info
 	std::string songName; // name of file being read from SD card
-	uint16_t sd_buffer1[BUFFER_SIZE]; // buffer of SD data
-	uint16_t sd_buffer2[BUFFER_SIZE]; // buffer of SD data
 	Pixel albumArtRGB[ALBUM_W];  // your final RGB buffer
 	
-	uint16_t* consumer_buf;
-	uint16_t* producer_buf;
-	TIM_HandleTypeDef* htim1_DIR; // pointer to timer handle for transducers
-	TIM_HandleTypeDef* htim2_EN; // pointer to timer handle for transducers
-	DMA_HandleTypeDef* hdma_ptr; // pointer to dma handle for tim up
-	bool need_refill; // bool that represents if a refill is needed for producer_buf
+	AudioOut* out; // owns the sample buffers and plays them
 	bool next_requested; //bool that represents if the next song is requested
 	bool play_requested;
 	bool pause_requested;
@@ -112,16 +104,6 @@ private:
 		f_closedir(&dir);
 	}
 
-	// resamples the input to be a 16 bit unsigned int with value from 0 to ARR
-	uint16_t resample_CCR (int16_t s16) {
-
-		uint32_t u16 = s16 + 32768;
-
-		uint32_t t = (uint32_t)u16 * (uint32_t)(htim2_EN->Instance->ARR);
-		uint16_t resampled = (uint16_t)(t >> 16);
-		return resampled;
-	}
-
 	// Minimal WAV header skip: find "data" chunk and its size.
 	FRESULT wav_seek_to_data (uint32_t *data_bytes_out) {
 		typedef struct { char id[4]; uint32_t size; } chunk_t;
@@ -160,7 +142,7 @@ private:
 		}
 	}
 
-	// Fill a CCR buffer from the WAV file
+	// Fill an output buffer from the WAV file
 	void fill_from_wav (uint16_t *dst) {
 		UINT received = 0;
 
@@ -169,18 +151,13 @@ private:
 		if (fr != FR_OK)
 			printf("f_read failed with code: %d\r\n", fr);
 
-		// Rescale in place
+		// Rescale in place for the output
 		uint32_t samples_read = received / sizeof(int16_t); //same as received >> 1
-		for (uint32_t i = 0; i < samples_read; i++) {
-			int16_t s16 = ((int16_t*)dst)[i];
-			//printf("s16 Val: %d\r\n", s16);
-			uint16_t resampled = resample_CCR(s16);
-			dst[i] = resampled;
-		}
+		out->convert(dst, samples_read);
 
-		// Pad remainder with zeros (i.e if end of file reached)
+		// Pad remainder with silence (i.e if end of file reached)
 		for (uint32_t i = samples_read; i < BUFFER_SIZE; i++) {
-			dst[i] = 0;
+			dst[i] = AudioOut::SILENCE;
 			if (continuous)
 				next_requested = true;
 		}
@@ -195,23 +172,17 @@ private:
 
 public:
 	SD() = default;
-	//htim1 --> 40kHz square wave PWM generation to toggle DIR that triggers DMA to put buff[s] --> htim2_CCR
-	//htim2 --> 80kHz modulated PWM
 
-	void init (TIM_HandleTypeDef* htim1_in, TIM_HandleTypeDef* htim2_in, DMA_HandleTypeDef* hdma_in, void (*song_finished_callback_in)(), void (*song_duration_callback_in)(uint32_t, uint32_t, uint32_t)) {
+	// out must already be initialized
+	void init (AudioOut* out_in, void (*song_finished_callback_in)(), void (*song_duration_callback_in)(uint32_t, uint32_t, uint32_t)) {
 //		printf("Initializing system... \r\n");
 		// set member variable values
-		htim1_DIR = htim1_in;
-		htim2_EN = htim2_in;
-		hdma_ptr = hdma_in;
+		out = out_in;
 		song_finished_callback = song_finished_callback_in;
 		song_duration_callback = song_duration_callback_in;
-		need_refill = false;
 		continuous = true;
 		current_wav = 0;
 
-		consumer_buf = sd_buffer1; // pointer to buffer currently being consumed by CCR
-		producer_buf = sd_buffer2; // pointer to buffer being filled from SD card
 		FRESULT fr;
 
 		// mount the SD card
@@ -240,25 +211,6 @@ public:
 		start_song();
 	}
 
-	// this function gets called when a buffer is emptied
-	void handle_dma_cb() {
-		//swap buffers
-		uint16_t* temp_buf = consumer_buf;
-		consumer_buf = producer_buf;
-		producer_buf = temp_buf;
-
-		// launch next DMA on the new consumer_buf
-		HAL_DMA_Start_IT(
-			hdma_ptr,
-			(uint32_t)consumer_buf,
-			(uint32_t)&htim2_EN->Instance->CCR1,
-			BUFFER_SIZE
-		);
-
-		//signal to refil the (now empty) producerbuffer
-		need_refill = true;
-	}
-
 	void start_song() {
 		 //Seek to WAV data
 		uint32_t data_bytes = 0;
@@ -268,48 +220,28 @@ public:
 		}
 
 		//Fill buffers and restart playback
-		fill_from_wav(consumer_buf);
-		fill_from_wav(producer_buf);
-
-		//set DIR to be a 40kHz sq wave (ARR = 2999, CCR = 1499)
-		htim1_DIR->Instance->CCR1 = 1499;
-
-		//start the direction PWM timer (40kHz square wave)
-		HAL_TIM_PWM_Start(htim1_DIR, TIM_CHANNEL_1);
-		//start the EN PWM timer (80kHz modulated wave)
-		HAL_TIM_PWM_Start(htim2_EN, TIM_CHANNEL_1);
-
-		__HAL_TIM_ENABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
-
-		HAL_DMA_RegisterCallback(hdma_ptr, HAL_DMA_XFER_CPLT_CB_ID, HAL_DMA_XferCpltCallback);
-		HAL_DMA_Start_IT(hdma_ptr,
-						(uint32_t)consumer_buf,
-						(uint32_t)(&htim2_EN->Instance->CCR1),
-						BUFFER_SIZE
-					);
-
+		fill_from_wav(out->get_consumer());
+		fill_from_wav(out->get_producer());
+		out->start();
 	}
 
 	void stop_all() {
-		HAL_DMA_Abort_IT(hdma_ptr);
-		__HAL_TIM_DISABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
-		HAL_TIM_PWM_Stop(htim1_DIR, TIM_CHANNEL_1);
-		HAL_TIM_PWM_Stop(htim2_EN, TIM_CHANNEL_1);
+		out->stop();
 	}
 
 	void pause() {
-		__HAL_TIM_DISABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+		out->pause();
 	}
 
 	void play() {
-		__HAL_TIM_ENABLE_DMA(htim1_DIR, TIM_DMA_UPDATE);
+		out->play();
 	}
 
 	// checks if the producer buffer needs to be refilled, called by main driver
 	void check_prod() {
-		if (need_refill) {
-			need_refill = false;
-			fill_from_wav(producer_buf);
+		if (out->refill_pending()) {
+			out->refilled();
+			fill_from_wav(out->get_producer());
 		}
 	}
 
@@ -352,7 +284,7 @@ public:
 	    }
 
 	    // prevent check_prod() from using old file
-	    need_refill = false;
+	    out->refilled();
 
 	    //NEW SKIPPING: STOP PLAYBACK SO NO GLITCH
 	    pause();
@@ -380,6 +312,40 @@ public:
 	    song_finished_callback();
 	}
 
+	// true while the producer buffer is waiting to be refilled, nothing slow should run until check_prod() does it
+	bool refill_pending(){
+		return out->refill_pending();
+	}
+
+	// reads a small settings file in one go, false if it is missing or shorter than len
+	bool read_file(const char* path, void* data, UINT len){
+		FIL file;
+		FRESULT fr = f_open(&file, path, FA_READ);
+		if (fr != FR_OK) return false;
+
+		UINT br;
+		fr = f_read(&file, data, len, &br);
+		f_close(&file);
+		if (fr != FR_OK) printf("f_read failed with code: %d\r\n", fr);
+		return fr == FR_OK && br == len;
+	}
+
+	// replaces a small settings file, only call between audio refills since the write blocks on the card
+	bool write_file(const char* path, const void* data, UINT len){
+		FIL file;
+		FRESULT fr = f_open(&file, path, FA_WRITE | FA_CREATE_ALWAYS);
+		if (fr != FR_OK){
+			printf("f_open failed with code: %d\r\n", fr);
+			return false;
+		}
+
+		UINT bw;
+		fr = f_write(&file, data, len, &bw);
+		FRESULT fr_close = f_close(&file);
+		if (fr != FR_OK || fr_close != FR_OK) printf("f_write failed with code: %d\r\n", fr != FR_OK ? fr : fr_close);
+		return fr == FR_OK && fr_close == FR_OK && bw == len;
+	}
+
 	std::string get_song_name(){
 		return songName.substr(0, songName.find_last_of('.'));
 	}
@@ -1,32 +1,177 @@
+/*
+ * Servo driver, up to four hobby servos on the channels of one PWM timer. Moves are shaped in the timer's update
+ * interrupt so each servo ramps up to its speed limit and brakes into the target instead of jumping there
+ */
+#pragma once
+
 #include "main.h"
+#include <cstdio>
+
+// pulse range of one servo and how fast it may be driven
+struct ServoConfig {
+	uint32_t channel; // TIM_CHANNEL_x
+	uint16_t min_us; // pulse at 0 degrees
+	uint16_t max_us; // pulse at range_deg
+	uint16_t range_deg;
+	uint32_t max_speed; // us per second
+	uint32_t max_accel; // us per second squared
+};
 
-// class for servo implementation
+// one axis, positions are timer counts in Q8 so slow moves still advance every period
 class Servo {
 private:
-	TIM_HandleTypeDef* htim_ptr; // pointer to timer handle for servo
-	uint32_t channel; // channel of timer that this servo is on
-	uint32_t min_ccr; // minimum ccr value for servo PWM output (1 ms duty cycle)
+	ServoConfig cfg;
+	int32_t ccr_per_us_q8; // timer counts per us of pulse
+	int32_t min_q8;
+	int32_t max_q8;
+	int32_t speed_q8; // counts per period
+	int32_t accel_q8; // counts per period per period
+
+	volatile int32_t target_q8; // written by set_target_us(), read by step() in the interrupt
+	int32_t pos_q8;
+	int32_t vel_q8;
+
+	static int32_t clamp(int32_t v, int32_t lo, int32_t hi){
+		return v < lo ? lo : (v > hi ? hi : v);
+	}
+
+public:
+	Servo() = default;
+
+	// ccr_per_us_q8 and period_hz come from the timer, start_us is where the servo is sent without a ramp
+	void init(ServoConfig const& cfg_in, int32_t ccr_per_us_q8_in, uint32_t period_hz, uint16_t start_us){
+		cfg = cfg_in;
+		ccr_per_us_q8 = ccr_per_us_q8_in;
+		min_q8 = cfg.min_us * ccr_per_us_q8;
+		max_q8 = cfg.max_us * ccr_per_us_q8;
+		speed_q8 = static_cast<int32_t>(cfg.max_speed * ccr_per_us_q8 / period_hz);
+		accel_q8 = static_cast<int32_t>(cfg.max_accel * ccr_per_us_q8 / period_hz / period_hz);
+		if(speed_q8 < 1) speed_q8 = 1;
+		if(accel_q8 < 1) accel_q8 = 1;
+		pos_q8 = clamp(start_us * ccr_per_us_q8, min_q8, max_q8);
+		target_q8 = pos_q8;
+		vel_q8 = 0;
+	}
+
+	uint32_t get_channel() const {
+		return cfg.channel;
+	}
+
+	// pulse to move to, clamped to the servo's range
+	void set_target_us(int32_t us){
+		target_q8 = clamp(us * ccr_per_us_q8, min_q8, max_q8);
+	}
+
+	// 0 to range_deg
+	void set_angle(uint16_t deg){
+		if(deg > cfg.range_deg)
+			deg = cfg.range_deg;
+		set_target_us(cfg.min_us + static_cast<int32_t>(deg) * (cfg.max_us - cfg.min_us) / cfg.range_deg);
+	}
+
+	// pulse currently being output, lags the target while the servo ramps
+	int32_t get_us() const {
+		return pos_q8 / ccr_per_us_q8;
+	}
+
+	uint16_t get_angle() const {
+		return static_cast<uint16_t>((get_us() - cfg.min_us) * cfg.range_deg / (cfg.max_us - cfg.min_us));
+	}
+
+	bool at_target() const {
+		return pos_q8 == target_q8;
+	}
+
+	// one PWM period of motion, returns the CCR for the next period
+	uint32_t step(){
+		int32_t dist = target_q8 - pos_q8;
+		int32_t dir = dist >= 0 ? 1 : -1;
+		int32_t remaining = dist * dir;
+		// speed toward the target, negative while still moving away from a target that changed sides
+		int32_t speed = vel_q8 * dir;
+
+		if(remaining <= accel_q8 && speed <= accel_q8 && speed >= -accel_q8){
+			// close and slow enough to stop in one period
+			pos_q8 = target_q8;
+			vel_q8 = 0;
+			return pos_q8 >> 8;
+		}
+
+		// brake once the distance a stop takes at max_accel reaches what is left, this is what keeps a fast move
+		// from carrying the horn past the target
+		int64_t stop_q8 = speed > 0 ? static_cast<int64_t>(speed) * speed / (2 * accel_q8) + speed / 2 : 0;
+		if(speed > speed_q8 || (speed > 0 && stop_q8 >= remaining)){
+			speed -= accel_q8;
+		}else{
+			speed = speed + accel_q8 > speed_q8 ? speed_q8 : speed + accel_q8;
+		}
+		if(speed > remaining){
+			speed = remaining;
+		}
+
+		vel_q8 = speed * dir;
+		pos_q8 = clamp(pos_q8 + vel_q8, min_q8, max_q8);
+		return pos_q8 >> 8;
+	}
+};
+
+// the servos sharing one timer, stepped together from its update interrupt
+class Servos {
+public:
+	static constexpr uint8_t MAX_SERVOS = 4; // channels per timer
+
+private:
+	TIM_HandleTypeDef* htim_ptr; // pointer to timer handle for servos
+	uint32_t period_hz;
+	int32_t ccr_per_us_q8;
+	Servo servos[MAX_SERVOS];
+	uint8_t num_servos;
 
 public:
-	Servo(TIM_HandleTypeDef* htim_in, uint32_t channel_in)
-		: htim_ptr(htim_in), channel(channel_in) {
-			uint32_t min_ccr = (htim_ptr->Instance->ARR + 1) / 20;
+	Servos() = default;
+
+	// the pulse scale comes from the timer ARR and the PWM rate it was set up for
+	void init(TIM_HandleTypeDef* htim_in, uint32_t period_hz_in){
+		htim_ptr = htim_in;
+		period_hz = period_hz_in;
+		uint32_t counts_per_period = __HAL_TIM_GET_AUTORELOAD(htim_ptr) + 1;
+		ccr_per_us_q8 = static_cast<int32_t>((static_cast<uint64_t>(counts_per_period) * period_hz << 8) / 1000000);
+		num_servos = 0;
+	}
+
+	// returns the servo's index, or -1 if the timer is full or the range does not fit in the period
+	int8_t add(ServoConfig const& cfg, uint16_t start_us){
+		if(num_servos == MAX_SERVOS || cfg.range_deg == 0 || cfg.min_us >= cfg.max_us ||
+				cfg.max_us > 1000000 / period_hz){
+			printf("Error adding servo\r\n");
+			return -1;
 		}
+		servos[num_servos].init(cfg, ccr_per_us_q8, period_hz, start_us);
+		__HAL_TIM_SET_COMPARE(htim_ptr, cfg.channel, servos[num_servos].get_us() * ccr_per_us_q8 >> 8);
+		return num_servos++;
+	}
 
-	// starts PWM generation for this servo
-	void Servo::start_servo() {
-		HAL_StatusTypeDef status = HAL_TIM_PWM_Start(this->m_tim_handle, this->m_channel);
-		while (status != HAL_OK); // catch error
+	Servo& operator[](uint8_t i){
+		return servos[i];
 	}
 
-	// adjust CCR to move servo to desired angle (0 - 180)
-	void Servo::set_servo_angle(uint8_t angle) {
-		// ensure angle is valid
-		if (angle > 180)
-			angle = 180;
+	// starts PWM generation and the update interrupt
+	void start(){
+		for(uint8_t i = 0; i < num_servos; ++i){
+			if(HAL_TIM_PWM_Start(htim_ptr, servos[i].get_channel()) != HAL_OK){
+				printf("Error starting servo PWM\r\n");
+			}
+		}
+		HAL_TIM_Base_Start_IT(htim_ptr);
+	}
 
-		// find CCR for angle and set based on htim_ptr ARR
-		uint32_t ccr = min_ccr + (angle * min_ccr) / 180;
-		__HAL_TIM_SET_COMPARE(htim_ptr, channel, ccr);
+	// called from HAL_TIM_PeriodElapsedCallback. the CCRs are preloaded, holding off the update event while they
+	// are written makes every channel switch to its new pulse in the same period
+	void handle_update(){
+		SET_BIT(htim_ptr->Instance->CR1, TIM_CR1_UDIS);
+		for(uint8_t i = 0; i < num_servos; ++i){
+			__HAL_TIM_SET_COMPARE(htim_ptr, servos[i].get_channel(), servos[i].step());
+		}
+		CLEAR_BIT(htim_ptr->Instance->CR1, TIM_CR1_UDIS);
 	}
 };
@@ -0,0 +1,205 @@
+/*
+ * Class for running the main loop as prioritized run-to-completion tasks, sleeping in WFI when nothing is ready
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdio>
+
+class TaskScheduler {
+public:
+	// per task numbers over the last stats window
+	struct TaskStats {
+		uint32_t cpu_permille; // share of the window spent running this task
+		uint32_t max_latency_us; // longest time from wake() to the task starting
+		uint32_t max_run_us;
+		uint32_t runs;
+	};
+
+private:
+	static constexpr int MAX_TASKS = 8;
+	static constexpr uint32_t STATS_WINDOW_MS = 1000;
+
+	struct task {
+		char const* name;
+		void (*run)();
+		uint8_t priority; // 0 runs first
+		uint32_t period_ms; // 0 if the task only runs when woken
+		uint32_t next_due;
+		volatile bool ready;
+		volatile uint32_t ready_cycles; // DWT count when it became ready
+
+		// stats for the current window
+		uint32_t run_cycles;
+		uint32_t max_latency_cycles;
+		uint32_t max_run_cycles;
+		uint32_t runs;
+		TaskStats stats;
+	};
+
+	task tasks[MAX_TASKS];
+	int num_tasks;
+
+	uint32_t cycles_per_us;
+	uint32_t window_start;
+	uint32_t window_start_cycles;
+	uint32_t idle_permille;
+	uint32_t busy_cycles;
+
+	// marks periodic tasks whose time has come as ready
+	void check_timers(uint32_t now){
+		for(int i = 0; i < num_tasks; ++i){
+			if(tasks[i].period_ms && static_cast<int32_t>(now - tasks[i].next_due) >= 0){
+				tasks[i].next_due += tasks[i].period_ms;
+				// a task that fell far behind skips the missed periods instead of running back to back
+				if(static_cast<int32_t>(now - tasks[i].next_due) >= 0){
+					tasks[i].next_due = now + tasks[i].period_ms;
+				}
+				wake(i);
+			}
+		}
+	}
+
+	// highest priority ready task, ties go to the one that has waited longest
+	int pick(){
+		int best = -1;
+		uint32_t now_cycles = DWT->CYCCNT;
+		for(int i = 0; i < num_tasks; ++i){
+			if(!tasks[i].ready){
+				continue;
+			}
+			if(best < 0 || tasks[i].priority < tasks[best].priority ||
+					(tasks[i].priority == tasks[best].priority && now_cycles - tasks[i].ready_cycles > now_cycles - tasks[best].ready_cycles)){
+				best = i;
+			}
+		}
+		return best;
+	}
+
+	void roll_stats(uint32_t now){
+		if(now - window_start < STATS_WINDOW_MS){
+			return;
+		}
+
+		uint32_t window_cycles = DWT->CYCCNT - window_start_cycles;
+		for(int i = 0; i < num_tasks; ++i){
+			task& t = tasks[i];
+			t.stats.cpu_permille = static_cast<uint64_t>(t.run_cycles) * 1000 / window_cycles;
+			t.stats.max_latency_us = t.max_latency_cycles / cycles_per_us;
+			t.stats.max_run_us = t.max_run_cycles / cycles_per_us;
+			t.stats.runs = t.runs;
+			t.run_cycles = 0;
+			t.max_latency_cycles = 0;
+			t.max_run_cycles = 0;
+			t.runs = 0;
+		}
+		idle_permille = 1000 - static_cast<uint64_t>(busy_cycles) * 1000 / window_cycles;
+		busy_cycles = 0;
+
+		window_start = now;
+		window_start_cycles = DWT->CYCCNT;
+	}
+
+public:
+	TaskScheduler() = default;
+
+	// the DWT cycle counter must already be running
+	void init(){
+		num_tasks = 0;
+		cycles_per_us = SystemCoreClock / 1000000;
+		window_start = HAL_GetTick();
+		window_start_cycles = DWT->CYCCNT;
+		idle_permille = 0;
+		busy_cycles = 0;
+	}
+
+	// returns the task id used with wake(), or -1 if there is no room
+	int add(char const* name, void (*run)(), uint8_t priority, uint32_t period_ms){
+		if(num_tasks >= MAX_TASKS){
+			printf("No more available tasks\r\n");
+			return -1;
+		}
+
+		task& t = tasks[num_tasks];
+		t.name = name;
+		t.run = run;
+		t.priority = priority;
+		t.period_ms = period_ms;
+		t.next_due = HAL_GetTick() + period_ms;
+		t.ready = false;
+		t.ready_cycles = 0;
+		t.run_cycles = 0;
+		t.max_latency_cycles = 0;
+		t.max_run_cycles = 0;
+		t.runs = 0;
+		t.stats = {0, 0, 0, 0};
+		return num_tasks++;
+	}
+
+	// safe from interrupts, all callers run at the same NVIC priority so they never race each other
+	void wake(int id){
+		if(id < 0 || tasks[id].ready){
+			return;
+		}
+		tasks[id].ready_cycles = DWT->CYCCNT;
+		tasks[id].ready = true;
+	}
+
+	// never returns
+	void run(){
+		while(true){
+			uint32_t now = HAL_GetTick();
+			check_timers(now);
+			roll_stats(now);
+
+			int id = pick();
+			if(id < 0){
+				// interrupts are masked so a wake() between the check and WFI still wakes the core,
+				// WFI returns on the pending interrupt and it runs once they are unmasked
+				__disable_irq();
+				if(pick() < 0){
+					__DSB();
+					__WFI();
+				}
+				__enable_irq();
+				continue;
+			}
+
+			task& t = tasks[id];
+			uint32_t start = DWT->CYCCNT;
+			uint32_t latency = start - t.ready_cycles;
+			t.ready = false;
+
+			(*t.run)();
+
+			uint32_t cycles = DWT->CYCCNT - start;
+			t.run_cycles += cycles;
+			busy_cycles += cycles;
+			++t.runs;
+			if(latency > t.max_latency_cycles) t.max_latency_cycles = latency;
+			if(cycles > t.max_run_cycles) t.max_run_cycles = cycles;
+		}
+	}
+
+	TaskStats const& get_stats(int id) const {
+		return tasks[id].stats;
+	}
+
+	uint32_t get_idle_permille() const {
+		return idle_permille;
+	}
+
+	// prints one task per call so a report never holds the CPU for long
+	void report(int id){
+		if(id < 0 || id >= num_tasks){
+			return;
+		}
+		TaskStats const& s = tasks[id].stats;
+		printf("%s: cpu %lu.%lu%% worst latency %luus worst run %luus runs %lu\r\n", tasks[id].name,
+				s.cpu_permille / 10, s.cpu_permille % 10, s.max_latency_us, s.max_run_us, s.runs);
+	}
+
+	int get_num_tasks() const {
+		return num_tasks;
+	}
+};
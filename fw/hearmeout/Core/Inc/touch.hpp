@@ -0,0 +1,212 @@
+/*
+ * Class for reading the XPT2046 touch controller, idle until PENIRQ fires and then sampled in SPI DMA bursts
+ */
+#pragma once
+
+#include "main.h"
+#include <cstdio>
+
+// filtered touch reading handed to the main loop
+struct TouchEvent {
+	uint16_t x;
+	uint16_t y;
+	uint16_t z;
+	bool pressed;
+};
+
+class Touch {
+private:
+	// Screen Constants
+	static constexpr int SCREEN_WIDTH = 480;
+	static constexpr int SCREEN_HEIGHT = 320;
+	static constexpr int SCREEN_PRESS_THRESHOLD = 100;
+
+	// adc values from calibration on 20-11-2025
+	static constexpr int32_t SHORT_AXIS_MIN = 180;
+	static constexpr int32_t SHORT_AXIS_MAX = 1900;
+	static constexpr int32_t LONG_AXIS_MIN = 180;
+	static constexpr int32_t LONG_AXIS_MAX = 2000;
+
+	// commands to sample x, y and z1, PD = 00 so PENIRQ stays enabled between conversions
+	static constexpr uint8_t SAMPLE_X = 0x94;
+	static constexpr uint8_t SAMPLE_Y = 0xD4;
+	static constexpr uint8_t SAMPLE_Z = 0xB4;
+
+	// Burst Constants
+	static constexpr int NUM_SAMPLES = 7; // per channel, the middle 3 after sorting are averaged
+	static constexpr int NUM_CHANNELS = 3;
+	static constexpr int FRAME_SIZE = 3; // command byte, then the result in the next two
+	static constexpr int BURST_SIZE = NUM_CHANNELS * NUM_SAMPLES * FRAME_SIZE;
+	static constexpr uint32_t SAMPLE_PERIOD_MS = 10; // time between bursts while the pen is down
+
+	// PENIRQ is wired to PD7
+	static constexpr uint16_t PENIRQ_PIN = GPIO_PIN_7;
+
+	enum TOUCH_STATE : uint8_t {
+		IDLE = 0x0, // waiting on PENIRQ
+		TRIGGERED = 0x1, // PENIRQ fired, main loop starts the first burst
+		SAMPLING = 0x2, // burst in flight
+		SAMPLED = 0x3, // burst done, main loop filters it
+		HOLDING = 0x4 // pen down, next burst after SAMPLE_PERIOD_MS
+	};
+
+	SPI_HandleTypeDef* touch_spi;
+	volatile TOUCH_STATE state;
+	uint32_t last_burst;
+	uint8_t tx_buf[BURST_SIZE];
+	uint8_t rx_buf[BURST_SIZE];
+	TouchEvent last;
+
+	void cs_low(){
+		HAL_GPIO_WritePin(T_CS_GPIO_Port, T_CS_Pin, GPIO_PIN_RESET);
+	}
+
+	void cs_high(){
+		HAL_GPIO_WritePin(T_CS_GPIO_Port, T_CS_Pin, GPIO_PIN_SET);
+	}
+
+	// PENIRQ also toggles during conversions, so the line is only unmasked while idle
+	void arm_penirq(){
+		__HAL_GPIO_EXTI_CLEAR_IT(PENIRQ_PIN);
+		EXTI->IMR1 |= PENIRQ_PIN;
+	}
+
+	void disarm_penirq(){
+		EXTI->IMR1 &= ~static_cast<uint32_t>(PENIRQ_PIN);
+	}
+
+	void start_burst(uint32_t now){
+		// the bus is shared with the FPGA audio stream, stay put and try again on the next service()
+		if(touch_spi->State != HAL_SPI_STATE_READY){
+			return;
+		}
+
+		last_burst = now;
+		state = TOUCH_STATE::SAMPLING;
+		cs_low();
+		if(HAL_SPI_TransmitReceive_DMA(touch_spi, tx_buf, rx_buf, BURST_SIZE) != HAL_OK){
+			printf("Error starting touch DMA\r\n");
+			cs_high();
+			state = TOUCH_STATE::IDLE;
+			arm_penirq();
+		}
+	}
+
+	// sorts the channel's readings and averages the middle three
+	uint16_t filter_channel(int channel){
+		uint16_t v[NUM_SAMPLES];
+		for(int i = 0; i < NUM_SAMPLES; ++i){
+			uint8_t const* frame = &rx_buf[(channel * NUM_SAMPLES + i) * FRAME_SIZE];
+			uint16_t value = ((frame[1] << 8) + frame[2]) >> 4;
+
+			// insertion sort, NUM_SAMPLES is small
+			int j = i;
+			while(j > 0 && v[j - 1] > value){
+				v[j] = v[j - 1];
+				--j;
+			}
+			v[j] = value;
+		}
+		return (v[NUM_SAMPLES / 2 - 1] + v[NUM_SAMPLES / 2] + v[NUM_SAMPLES / 2 + 1]) / 3;
+	}
+
+	// maps a raw reading onto [0, size] with the calibration range
+	static uint16_t scale(int32_t raw, int32_t min, int32_t max, int32_t size){
+		int32_t scaled = (raw - min) * size / (max - min);
+		if(scaled < 0) scaled = 0;
+		if(scaled > size) scaled = size;
+		return scaled;
+	}
+
+public:
+	Touch() = default;
+
+	void init(SPI_HandleTypeDef* touch_spi_in){
+		printf("Initializing Touch\r\n");
+
+		touch_spi = touch_spi_in;
+		last = {0, 0, 0, false};
+
+		// the burst is always the same, only the results change
+		uint8_t const cmds[NUM_CHANNELS] = {SAMPLE_X, SAMPLE_Y, SAMPLE_Z};
+		for(int c = 0; c < NUM_CHANNELS; ++c){
+			for(int i = 0; i < NUM_SAMPLES; ++i){
+				uint8_t* frame = &tx_buf[(c * NUM_SAMPLES + i) * FRAME_SIZE];
+				frame[0] = cmds[c];
+				frame[1] = 0;
+				frame[2] = 0;
+			}
+		}
+
+		cs_high();
+		state = TOUCH_STATE::IDLE;
+		arm_penirq();
+
+		// already pressed at boot, the edge is gone so start right away
+		if(HAL_GPIO_ReadPin(GPIOD, PENIRQ_PIN) == GPIO_PIN_RESET){
+			disarm_penirq();
+			state = TOUCH_STATE::TRIGGERED;
+		}
+	}
+
+	// called from HAL_GPIO_EXTI_Callback, PENIRQ is active low
+	void handle_penirq(){
+		if(state == TOUCH_STATE::IDLE && HAL_GPIO_ReadPin(GPIOD, PENIRQ_PIN) == GPIO_PIN_RESET){
+			disarm_penirq();
+			state = TOUCH_STATE::TRIGGERED;
+		}
+	}
+
+	// called from HAL_SPI_TxRxCpltCallback when the burst is in rx_buf
+	void handle_dma_cb(){
+		cs_high();
+		state = TOUCH_STATE::SAMPLED;
+	}
+
+	// starts bursts and filters finished ones, returns true with a new press/move/release in event
+	// called by main driver
+	bool service(uint32_t now, TouchEvent* event){
+		switch(state){
+		case TOUCH_STATE::TRIGGERED:
+			start_burst(now);
+			return false;
+		case TOUCH_STATE::HOLDING:
+			if(now - last_burst >= SAMPLE_PERIOD_MS){
+				start_burst(now);
+			}
+			return false;
+		case TOUCH_STATE::SAMPLED:
+			break;
+		default:
+			return false;
+		}
+
+		uint16_t raw_x = filter_channel(0);
+		uint16_t raw_y = filter_channel(1);
+		uint16_t raw_z = filter_channel(2);
+
+		if(raw_z >= SCREEN_PRESS_THRESHOLD){
+			last.x = scale(raw_x, LONG_AXIS_MIN, LONG_AXIS_MAX, SCREEN_WIDTH);
+			last.y = scale(raw_y, SHORT_AXIS_MIN, SHORT_AXIS_MAX, SCREEN_HEIGHT);
+			last.z = raw_z;
+			last.pressed = true;
+			state = TOUCH_STATE::HOLDING;
+			*event = last;
+			return true;
+		}
+
+		// pen lifted, go back to waiting on PENIRQ
+		bool was_pressed = last.pressed;
+		last.z = 0;
+		last.pressed = false;
+		state = TOUCH_STATE::IDLE;
+		arm_penirq();
+		*event = last;
+		return was_pressed;
+	}
+
+	// most recent filtered reading, for consumers that poll (LVGL)
+	TouchEvent const& get_last() const {
+		return last;
+	}
+};
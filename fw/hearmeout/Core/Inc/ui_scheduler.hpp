@@ -0,0 +1,95 @@
+/*
+ * Class for collecting visible state changes and rendering them at a fixed frame rate from the main loop
+ */
+#pragma once
+
+#include "main.h"
+
+class UiScheduler {
+public:
+	// parts of the UI that need to be redrawn, subsystems post these instead of drawing themselves
+	enum DIRTY : uint32_t {
+		PROGRESS = 0x1 << 0,
+		TIME = 0x1 << 1,
+		SONG = 0x1 << 2, // album art and title
+		TRACKING = 0x1 << 3
+	};
+
+	// counters over the last full second
+	struct Stats {
+		uint32_t changes_per_s; // posts that marked something new as dirty
+		uint32_t frames_per_s;
+		uint32_t render_us_per_s;
+	};
+
+private:
+	static constexpr uint32_t STATS_WINDOW_MS = 1000;
+
+	void (*render)(uint32_t dirty); // draws whatever is flagged in dirty
+	uint32_t frame_ms; // minimum time between two frames
+	uint32_t last_frame;
+	volatile uint32_t dirty;
+
+	// Stats Variables
+	uint32_t cycles_per_us;
+	uint32_t window_start;
+	volatile uint32_t changes;
+	uint32_t frames;
+	uint32_t render_cycles;
+	Stats stats;
+
+public:
+	UiScheduler() = default;
+
+	void init(void (*render_in)(uint32_t), uint32_t frame_ms_in){
+		render = render_in;
+		frame_ms = frame_ms_in;
+		last_frame = HAL_GetTick();
+		dirty = 0;
+
+		// frames are timed with the DWT cycle counter, which must already be running
+		cycles_per_us = SystemCoreClock / 1000000;
+
+		window_start = last_frame;
+		changes = 0;
+		frames = 0;
+		render_cycles = 0;
+		stats = {0, 0, 0};
+	}
+
+	// safe from interrupts, the flags are merged with an atomic or
+	void post(uint32_t flags){
+		uint32_t prev = __atomic_fetch_or(&dirty, flags, __ATOMIC_RELAXED);
+		if((prev & flags) != flags){
+			__atomic_fetch_add(&changes, 1, __ATOMIC_RELAXED);
+		}
+	}
+
+	// renders one frame if something changed and the frame budget allows it, call it from the main loop
+	// only when no audio refill is pending
+	void service(uint32_t now){
+		if(now - window_start >= STATS_WINDOW_MS){
+			stats.changes_per_s = __atomic_exchange_n(&changes, 0, __ATOMIC_RELAXED);
+			stats.frames_per_s = frames;
+			stats.render_us_per_s = render_cycles / cycles_per_us;
+			frames = 0;
+			render_cycles = 0;
+			window_start = now;
+		}
+
+		if(dirty == 0 || now - last_frame < frame_ms){
+			return;
+		}
+		last_frame = now;
+
+		uint32_t flags = __atomic_exchange_n(&dirty, 0, __ATOMIC_RELAXED);
+		uint32_t start = DWT->CYCCNT;
+		(*render)(flags);
+		render_cycles += DWT->CYCCNT - start;
+		++frames;
+	}
+
+	Stats const& get_stats() const {
+		return stats;
+	}
+};
@@ -5,14 +5,30 @@
 #include "main.h"
 #include "fatfs.h"
 #include "sd.hpp"
+#include "audio_out.hpp"
 #include "screen.hpp"
+#include "touch.hpp"
 #include "palette.hpp"
 #include "gimbal.hpp"
 #include "audio_jack.hpp"
+#include "ui_scheduler.hpp"
+#include "event_queue.hpp"
+#include "task_scheduler.hpp"
+#include "led_channel.hpp"
+
+// set to 1 to draw the UI with the bundled LVGL instead of the hand drawn Screen widgets
+#ifndef USE_LVGL_UI
+#define USE_LVGL_UI 0
+#endif
+
+#if USE_LVGL_UI
+#include "lvgl_port.hpp"
+#else
+#include "marquee.hpp"
+#endif
 
 extern TIM_HandleTypeDef htim1;
 extern TIM_HandleTypeDef htim2;
-extern TIM_HandleTypeDef htim3;
 extern TIM_HandleTypeDef htim4;
 extern TIM_HandleTypeDef htim5;
 extern UART_HandleTypeDef huart2;
@@ -24,10 +40,48 @@ extern OPAMP_HandleTypeDef hopamp2;
 extern I2C_HandleTypeDef hi2c1;
 
 SD sd; // sd object used to handle updating CCR based on audio file
+AudioOut audio_out; // plays the samples SD reads, TIM1 / TIM2 or the FPGA depending on USE_FPGA_AUDIO
 Screen screen;
+Touch touch;
 AudioJack jack;
 Gimbal gimbal; // need to update cam class to have default constuctor with init function
-volatile bool send_req = false;
+LedChannel leds; // status, SD card and AUX LEDs on the FPGA
+static constexpr uint8_t LED_FPGA_ADDRESS = 69;
+static constexpr uint8_t LED_BREATHE_PERIOD = 3; // about 2s per breath
+static constexpr char const* GIMBAL_CAL_PATH = "0://gimbal.cal";
+
+EventQueue<Event, 32> events; // everything the interrupts hand to events_task()
+IsrStats isr_stats[EVENT_TYPE::NUM_EVENT_TYPES]; // per source run count and worst case cycles
+uint32_t reported_drops;
+
+// main loop tasks, lower priority number runs first: audio refill > tracking > touch > UI
+TaskScheduler tasks;
+int events_task_id;
+int audio_task_id;
+int tracking_task_id;
+int touch_task_id;
+int ui_task_id;
+int stats_task_id;
+bool camera_tick; // set by events_task when TIM5 asked for a new pixy request
+bool uart_error; // set by events_task when the pixy RX DMA stopped on a line error
+
+#if USE_LVGL_UI
+LvglPort lvgl;
+LvglPort& ui = lvgl; // backend the GUI layouts are drawn with
+#else
+Screen& ui = screen; // backend the GUI layouts are drawn with
+Marquee title; // song title, scrolled with the panel's hardware scroll when it is too long
+#endif
+
+UiScheduler ui_sched; // redraws whatever the subsystems marked as changed, at most once per frame
+static constexpr uint32_t UI_FRAME_MS = 33;
+static constexpr uint32_t SONG_BYTES_PER_S = 40000 * sizeof(int16_t); // songs are 40kHz 16 bit mono
+
+// latest UI state posted by the subsystems, drawn by render_ui()
+volatile int progress_px;
+volatile int elapsed_s;
+volatile int total_s;
+bool tracking;
 
 enum STATE : uint8_t{
 	SD_CARD = 0,
@@ -36,9 +90,16 @@ enum STATE : uint8_t{
 
 STATE state;
 STATE prev_state;
+bool paused; // the LEDs breathe while the active input is paused
 
 // BEGIN //
 
+// status stays lit, the other two show the selected input, the FPGA animates them on its own
+void update_leds(){
+	LedChannel::ANIMATION mode = paused ? LedChannel::ANIMATION::BREATHE : LedChannel::ANIMATION::STATIC;
+	leds.set_leds(0xFF, state == STATE::SD_CARD ? 0xFF : 0x00, state == STATE::AUDIO_JACK ? 0xFF : 0x00, mode);
+}
+
 void pause_callback(){
 	printf("Pause\r\n");
 	if(state == STATE::SD_CARD){
@@ -46,6 +107,8 @@ void pause_callback(){
 	}else if(state == STATE::AUDIO_JACK){
 		jack.request_pause();
 	}
+	paused = true;
+	update_leds();
 }
 
 void play_callback(){
@@ -55,6 +118,9 @@ void play_callback(){
 	}else if(state == STATE::AUDIO_JACK){
 		jack.request_play();
 	}
+	paused = false;
+	update_leds();
+	leds.request_status();
 }
 
 void skip_callback(){
@@ -62,122 +128,440 @@ void skip_callback(){
 	sd.request_next();
 }
 
+// the listener has to stand still in view of the camera until it finishes
+void calibrate_callback(){
+	printf("Calibrate\r\n");
+	gimbal.calibrate();
+}
+
+// trades the block processing for the lowest latency, the ADC DMA writes the EN duty directly
+void live_callback(){
+	printf("Live\r\n");
+	jack.request_toggle_passthrough();
+}
+
+// steps through the EQ presets, both inputs share the one in the output
+void eq_callback(){
+	audio_out.get_eq().next_preset();
+}
+
+// steps through the envelope pre-distortion for the air demodulation
+void am_callback(){
+	audio_out.get_mod().next_mode();
+}
+
+// steps the modulation index down a quarter at a time
+void depth_callback(){
+	audio_out.get_mod().next_index();
+}
+
 void input_callback(){
 	printf("Input\r\n");
 	state = (state == STATE::SD_CARD) ? STATE::AUDIO_JACK : STATE::SD_CARD;
 }
 
 void render_sd_gui(){
-	screen.clear();
+	ui.clear();
+
+	ui.draw_button(15, 15, 135, 90, &pause_callback, "PAUSE");
+
+	ui.draw_button(15, 115, 135, 90, &play_callback, "PLAY");
+
+	ui.draw_button(15, 215, 135, 90, &skip_callback, "SKIP");
 
-	screen.draw_button(15, 15, 200, 90, &pause_callback, "PAUSE");
+	ui.draw_button(155, 15, 60, 90, &depth_callback, "IDX");
 
-	screen.draw_button(15, 115, 200, 90, &play_callback, "PLAY");
+	ui.draw_button(155, 115, 60, 90, &am_callback, "AM");
 
-	screen.draw_button(15, 215, 200, 90, &skip_callback, "SKIP");
+	ui.draw_button(155, 215, 60, 90, &eq_callback, "EQ");
 
-	screen.draw_button(230, 245, 235, 60, &input_callback, "AUX");
+	ui.draw_button(318, 245, 152, 60, &input_callback, "AUX");
+
+#if USE_LVGL_UI
+	lvgl.draw_progress_bar(318, 220, 152, 10);
+#endif
+
+	// everything around the buttons is drawn by render_ui() on the next frame
+	ui_sched.post(UiScheduler::DIRTY::SONG | UiScheduler::DIRTY::PROGRESS | UiScheduler::DIRTY::TIME | UiScheduler::DIRTY::TRACKING);
 }
 
 void render_jack_gui(){
-	screen.clear();
-	screen.draw_button(15, 15, 200, 90, &pause_callback, "MUTE");
+#if !USE_LVGL_UI
+	title.stop();
+#endif
+	ui.clear();
+	ui.draw_button(15, 15, 135, 90, &pause_callback, "MUTE");
+
+	ui.draw_button(15, 115, 135, 90, &play_callback, "UNMUTE");
+
+	ui.draw_button(15, 215, 135, 90, &calibrate_callback, "CALIBRATE");
+
+	ui.draw_button(155, 15, 60, 90, &depth_callback, "IDX");
+
+	ui.draw_button(155, 115, 60, 90, &am_callback, "AM");
+
+	ui.draw_button(155, 215, 60, 90, &eq_callback, "EQ");
 
-	screen.draw_button(15, 115, 200, 90, &play_callback, "UNMUTE");
+	// below the tracking square, which stays in the top corner on both screens
+	ui.draw_button(318, 26, 152, 36, &live_callback, "LIVE");
 
-	screen.draw_button(230, 245, 235, 60, &input_callback, "SD CARD");
+	ui.draw_button(318, 245, 152, 60, &input_callback, "SD CARD");
+
+#if USE_LVGL_UI
+	lvgl.refresh();
+#endif
+
+	ui_sched.post(UiScheduler::DIRTY::TRACKING);
 }
 
-// main loop
-void event_loop() {
-	while (true) {
-		if (send_req) {
-			send_req = false;
-			gimbal.request_pos();
+// draws the parts of the UI flagged in dirty, only ever called by ui_sched outside of an audio refill
+void render_ui(uint32_t dirty){
+	if(state == STATE::SD_CARD){
+		if(dirty & UiScheduler::DIRTY::SONG){
+#if USE_LVGL_UI
+			// album art is drawn straight to the panel, so LVGL has to be done with the area first
+			lvgl.refresh();
+#endif
+			sd.display_image(sd.get_song_name() + ".bmp", 318, 36, 152, 150, &screen);
+#if !USE_LVGL_UI
+			title.start(sd.get_song_name());
+#endif
 		}
 
-		gimbal.poll_dma();
-
-		// pause one of either the SD card or the Audio Jack in order to prevent them from both
-		if(state == STATE::SD_CARD){
-			jack.pause();
-		}else if(state == STATE::AUDIO_JACK){
-			sd.pause();
+		if(dirty & UiScheduler::DIRTY::PROGRESS){
+			int pixel_percent = progress_px;
+#if USE_LVGL_UI
+			// SPI3 may be busy with a flush, LVGL redraws the bar on its next pass
+			lvgl.set_progress(pixel_percent);
+#else
+			screen.draw_box(318 + pixel_percent, 220, 152 - pixel_percent, 10, PROGRESS_BAR_BACKGROUND_R, PROGRESS_BAR_BACKGROUND_G, PROGRESS_BAR_BACKGROUND_B);
+			screen.draw_box(318, 220, pixel_percent, 10, PROGRESS_BAR_FOREGROUND_R, PROGRESS_BAR_FOREGROUND_G, PROGRESS_BAR_FOREGROUND_B);
+#endif
 		}
 
-		// change the UI to the corresponding input
-		if(state != prev_state){
-			// pausing both the audio jack and the sd card will prevent any unwanted noising while re-rendering the screen
-			jack.pause();
-			sd.pause();
-			if(state == STATE::SD_CARD){
-				render_sd_gui();
-				sd.display_image(sd.get_song_name() + ".bmp", 272, 36, 152, 150, &screen);
-				sd.request_play();
-				// init the LED
-				uint8_t start_sd_card_led[] = {0x21};
-				uint8_t stop_aux_led[] = {0x30};
-				HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), start_sd_card_led, sizeof(start_sd_card_led), (uint32_t)HAL_Delay);
-				HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), stop_aux_led, sizeof(stop_aux_led), (uint32_t)HAL_Delay);
-			}else if(state == STATE::AUDIO_JACK){
-				render_jack_gui();
-				sd.display_image("0://aux.bmp", 272, 66, 152, 150, &screen);
-				jack.request_play();
-				// init the LED
-				uint8_t start_sd_card_led[] = {0x20};
-				uint8_t stop_aux_led[] = {0x31};
-				HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), start_sd_card_led, sizeof(start_sd_card_led), (uint32_t)HAL_Delay);
-				HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), stop_aux_led, sizeof(stop_aux_led), (uint32_t)HAL_Delay);
+#if !USE_LVGL_UI
+		// elapsed / total time above the progress bar
+		if(dirty & UiScheduler::DIRTY::TIME){
+			int elapsed = elapsed_s;
+			int total = total_s;
+			char time_str[24];
+			snprintf(time_str, sizeof(time_str), "%d:%02d / %d:%02d", elapsed / 60, elapsed % 60, total / 60, total % 60);
+
+			uint8_t const time_rgb[] = {TITLE_R, TITLE_G, TITLE_B};
+			uint8_t const background_rgb[] = {BACKGROUND_R, BACKGROUND_G, BACKGROUND_B};
+			uint16_t end_x = screen.draw_text(318, 196, time_str, FONT_SMALL, time_rgb, background_rgb);
+			// the string can get narrower, clear whatever the last one left behind
+			if(end_x < 318 + 152){
+				screen.draw_box(end_x, 196, 318 + 152 - end_x, FONT_SMALL.line_h, BACKGROUND_R, BACKGROUND_G, BACKGROUND_B);
 			}
 		}
-		prev_state = state;
+#endif
+	}
 
-		// run the event loop for one of the the SD Card or the Audio Jack
+#if !USE_LVGL_UI
+	// small square above the album art, lit while the camera sees the target
+	if(dirty & UiScheduler::DIRTY::TRACKING){
+		if(tracking){
+			screen.draw_box(318, 10, 12, 12, TRACKING_ON_R, TRACKING_ON_G, TRACKING_ON_B);
+		}else{
+			screen.draw_box(318, 10, 12, 12, TRACKING_OFF_R, TRACKING_OFF_G, TRACKING_OFF_B);
+		}
+	}
+#endif
+}
+
+#if USE_LVGL_UI
+// keeps the SD refill going while LVGL is waiting on a display flush
+void service_audio(){
+	if(state == STATE::SD_CARD){
+		sd.check_prod();
+	}
+}
+#endif
+
+// touch is filtered here, so button callbacks and their redraws run in the main loop
+void touch_task(){
+	TouchEvent touch_event;
+	if(touch.service(HAL_GetTick(), &touch_event)){
+#if !USE_LVGL_UI
+		screen.check_buttons(touch_event.x, touch_event.y, touch_event.z);
+#endif
+	}
+}
+
+// keeps the active source's buffers full and applies play/pause/skip requests
+void audio_task(){
+	// pause one of either the SD card or the Audio Jack in order to prevent them from both
+	if(state == STATE::SD_CARD){
+		jack.pause();
+		sd.check_prod();
+		sd.check_next();
+		audio_out.service();
+	}else if(state == STATE::AUDIO_JACK){
+		// the SD card stays paused since the ui task switched over, the jack now feeds the output itself
+		jack.check_next();
+		jack.service();
+		audio_out.service();
+	}
+}
+
+// reads pixy responses, which also send the next request, and runs the servo loop on each camera tick
+void tracking_task(){
+	// a dropped error event would leave the receiver stopped for good, so a stopped one is restarted as well
+	if(uart_error || huart2.RxState != HAL_UART_STATE_BUSY_RX){
+		uart_error = false;
+		gimbal.restart_rx();
+	}
+	gimbal.process_rx();
+
+	if(camera_tick){
+		camera_tick = false;
+		gimbal.control_step(HAL_GetTick());
+		gimbal.check_request(HAL_GetTick());
+	}
+
+	// saved once the audio buffers are full, the write blocks on the card
+	Gimbal::Calibration cal;
+	if(!sd.refill_pending() && gimbal.take_calibration(&cal)){
+		if(sd.write_file(GIMBAL_CAL_PATH, &cal, sizeof(cal))){
+			printf("Gimbal calibration saved\r\n");
+		}
+	}
+
+	bool now_tracking = gimbal.is_tracking(HAL_GetTick());
+	if(now_tracking != tracking){
+		tracking = now_tracking;
+		ui_sched.post(UiScheduler::DIRTY::TRACKING);
+	}
+}
+
+// input switching and everything drawn on the screen
+void ui_task(){
+	// change the UI to the corresponding input
+	if(state != prev_state){
+		// pausing both the audio jack and the sd card will prevent any unwanted noising while re-rendering the screen
+		jack.pause();
+		sd.pause();
 		if(state == STATE::SD_CARD){
-			sd.check_prod();
-			sd.check_next();
+			render_sd_gui();
+			sd.request_play();
+			paused = false;
+			update_leds();
 		}else if(state == STATE::AUDIO_JACK){
-			jack.check_next();
-			// No Events for the audio jack
+			render_jack_gui();
+			sd.display_image("0://aux.bmp", 318, 66, 152, 150, &screen);
+			jack.request_play();
+			paused = false;
+			update_leds();
 		}
-    }
+		// the new source's play request is handled by the audio task
+		tasks.wake(audio_task_id);
+	}
+	prev_state = state;
+
+	// LED commands are sent from the I2C interrupt, this only picks up ones that could not start
+	leds.service();
+
+#if !USE_LVGL_UI
+	if(state == STATE::SD_CARD){
+		title.tick(HAL_GetTick());
+	}
+#endif
+
+	// the UI only gets the time left over once the audio buffers are full
+	if(!sd.refill_pending()){
+		ui_sched.service(HAL_GetTick());
+	}
+
+#if USE_LVGL_UI
+	// only runs after the refill above, partial flushes keep each call short
+	lvgl.handle();
+#endif
+}
+
+// hands queued interrupt events to the tasks that handle them
+void events_task(){
+	Event event;
+	while(events.pop(&event)){
+		switch(event.type){
+		case EVENT_TYPE::AUDIO_DMA_DONE:
+#if USE_FPGA_AUDIO
+			// the shared SPI bus is free again, a held off touch burst can go
+			tasks.wake(touch_task_id);
+#endif
+			tasks.wake(audio_task_id);
+			break;
+		case EVENT_TYPE::AUDIO_DRQ:
+		case EVENT_TYPE::AUX_BLOCK:
+			tasks.wake(audio_task_id);
+			break;
+		case EVENT_TYPE::TOUCH_PENIRQ:
+			tasks.wake(touch_task_id);
+			break;
+		case EVENT_TYPE::TOUCH_DMA_DONE:
+			tasks.wake(touch_task_id);
+#if USE_FPGA_AUDIO
+			// the shared SPI bus is free again
+			tasks.wake(audio_task_id);
+#endif
+			break;
+		case EVENT_TYPE::CAMERA_TICK:
+			// fixed rate servo step, requests are chained by the responses themselves
+			camera_tick = true;
+			tasks.wake(tracking_task_id);
+			break;
+		case EVENT_TYPE::UART_RX:
+			tasks.wake(tracking_task_id);
+			break;
+		case EVENT_TYPE::UART_ERROR:
+			uart_error = true;
+			tasks.wake(tracking_task_id);
+			break;
+		default:
+			break;
+		}
+	}
+
+	if(events.get_dropped() != reported_drops){
+		reported_drops = events.get_dropped();
+		printf("Event queue full, %lu events dropped\r\n", reported_drops);
+	}
+}
+
+// runs and worst case time of each interrupt source since the last report, the ones that did not run are skipped.
+// in cycles since most of them finish well inside a microsecond
+void report_isr_stats(){
+	for(uint8_t i = 0; i < EVENT_TYPE::NUM_EVENT_TYPES; ++i){
+		uint32_t runs, worst_cycles;
+		isr_stats[i].take(&runs, &worst_cycles);
+		if(runs){
+			printf("isr %s: %lu runs worst %lu cycles\r\n", EVENT_NAMES[i], runs, worst_cycles);
+		}
+	}
+}
+
+// prints one task's CPU share and worst latency per run, and the rest once every task has had its turn
+void stats_task(){
+	static int next = 0;
+	tasks.report(next);
+	next = (next + 1) % tasks.get_num_tasks();
+	if(next == 0){
+		uint32_t idle = tasks.get_idle_permille();
+		printf("idle: %lu.%lu%%\r\n", idle / 10, idle % 10);
+		UiScheduler::Stats const& ui_stats = ui_sched.get_stats();
+		printf("ui: %lu changes/s %lu frames/s render %luus/s\r\n", ui_stats.changes_per_s, ui_stats.frames_per_s,
+				ui_stats.render_us_per_s);
+		report_isr_stats();
+		gimbal.report(HAL_GetTick());
+		jack.report();
+		audio_out.get_eq().report();
+		audio_out.get_mod().report(state == STATE::SD_CARD ? "sd" : "aux");
+	}
 }
 
 void song_finished_callback(){
 	printf("Song Finished\r\n");
-	sd.display_image(sd.get_song_name() + ".bmp", 272, 36, 152, 150, &screen);
+	ui_sched.post(UiScheduler::DIRTY::SONG);
 }
 
+// runs inside the audio refill, so it only records the new values and lets render_ui() draw them
 void song_duration_callback(uint32_t current_song_duration, uint32_t prev_song_duration, uint32_t total_song_duration){
-	int pixel_percent = (int)(((float)current_song_duration/(float)total_song_duration) * 152);
-	screen.draw_box(272 + pixel_percent, 220, 152 - pixel_percent, 10, PROGRESS_BAR_BACKGROUND_R, PROGRESS_BAR_BACKGROUND_G, PROGRESS_BAR_BACKGROUND_B);
-	screen.draw_box(272, 220, pixel_percent, 10, PROGRESS_BAR_FOREGROUND_R, PROGRESS_BAR_FOREGROUND_G, PROGRESS_BAR_FOREGROUND_B);
+	if(total_song_duration == 0){
+		return;
+	}
+
+	// the last refill counts a whole buffer even when the file ended part way through it
+	if(current_song_duration > total_song_duration){
+		current_song_duration = total_song_duration;
+	}
+
+	int pixel_percent = (uint64_t)current_song_duration * 152 / total_song_duration;
+	if(pixel_percent != progress_px){
+		progress_px = pixel_percent;
+		ui_sched.post(UiScheduler::DIRTY::PROGRESS);
+	}
+
+	int elapsed = current_song_duration / SONG_BYTES_PER_S;
+	int total = total_song_duration / SONG_BYTES_PER_S;
+	if(elapsed != elapsed_s || total != total_s){
+		elapsed_s = elapsed;
+		total_s = total;
+		ui_sched.post(UiScheduler::DIRTY::TIME);
+	}
 }
 
-// initialize program and start event_loop
+// initialize program and start the task scheduler
 void init() {
+	// cycle counter used to time the interrupts and UI frames
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	events.init();
+	reported_drops = 0;
+	camera_tick = false;
+	uart_error = false;
+
+	// tasks are registered before any interrupt can post an event
+	tasks.init();
+	events_task_id = tasks.add("events", &events_task, 0, 0);
+	audio_task_id = tasks.add("audio", &audio_task, 1, 2);
+	tracking_task_id = tasks.add("tracking", &tracking_task, 2, 0);
+	touch_task_id = tasks.add("touch", &touch_task, 3, 10);
+	ui_task_id = tasks.add("ui", &ui_task, 4, 10);
+	stats_task_id = tasks.add("stats", &stats_task, 5, 2000);
+
 	gimbal.init(&htim4, &htim5, &huart2);
 	gimbal.request_pos();
 
-	jack.init(&hadc1, &hopamp2);
-	screen.init(&hspi3, &hspi2, &htim3);
+	jack.init(&hadc1, &hopamp2, &htim1, &htim2, &audio_out);
+	screen.init(&hspi3);
+	touch.init(&hspi2);
+#if !USE_LVGL_UI
+	// the column between the buttons and the album art, kept clear of everything else
+	title.init(&screen, 220, 10, 98);
+#endif
+
+#if USE_LVGL_UI
+	lvgl.init(&screen, &touch, &hspi3, &service_audio);
+#endif
+
+	ui_sched.init(&render_ui, UI_FRAME_MS);
+	tracking = false;
 
 	// we default to playing from the SD_Card
 	state = STATE::SD_CARD;
 	prev_state = STATE::SD_CARD;
 	render_sd_gui();
 
-	sd.init(&htim1, &htim2, &hdma_tim1_up, &song_finished_callback, &song_duration_callback);
+#if USE_FPGA_AUDIO
+	audio_out.init(&hspi2);
+#else
+	audio_out.init(&htim1, &htim2, &hdma_tim1_up);
+#endif
+	sd.init(&audio_out, &song_finished_callback, &song_duration_callback);
+
+	// the mapping from the last calibration, the defaults in Gimbal::init() otherwise
+	Gimbal::Calibration cal;
+	if(sd.read_file(GIMBAL_CAL_PATH, &cal, sizeof(cal)) && gimbal.set_calibration(cal)){
+		printf("Gimbal calibration loaded\r\n");
+	}
+
+	// init the LED, the commands go out in the background while the scheduler starts
+	leds.init(&hi2c1, LED_FPGA_ADDRESS);
+	leds.set_period(LED_BREATHE_PERIOD);
+	paused = false;
+	update_leds();
 
-	// init the LED
-	uint8_t start_status_led[] = {0x11};
-	uint8_t clear_sd_card_led[] = {0x21};
-	uint8_t clear_aux_led[] = {0x30};
-	HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), start_status_led, sizeof(start_status_led), (uint32_t)HAL_Delay);
-	HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), clear_sd_card_led, sizeof(clear_sd_card_led), (uint32_t)HAL_Delay);
-	HAL_I2C_Master_Transmit(&hi2c1, (69 << 1), clear_aux_led, sizeof(clear_aux_led), (uint32_t)HAL_Delay);
+	// sleeps in WFI whenever no task is ready
+	tasks.run();
+}
 
-	event_loop();
+// queues an event for events_task() and records how long the interrupt took up to here
+void post_event(EVENT_TYPE type, uint32_t start_cycles){
+	events.push({type, HAL_GetTick()});
+	tasks.wake(events_task_id);
+	isr_stats[type].record(start_cycles);
 }
 
 // HAL C functions
@@ -185,43 +569,113 @@ extern "C" {
 
 // DMA callback when buffer is emptied
 void HAL_DMA_XferCpltCallback (DMA_HandleTypeDef *hdma) {
-	if(hdma == &hdma_tim1_up)
-		sd.handle_dma_cb();
+	uint32_t start = DWT->CYCCNT;
+#if !USE_FPGA_AUDIO
+	if(hdma == &hdma_tim1_up){
+		// the next buffer has to start right away, only the refill is left to the main loop
+		audio_out.handle_dma_cb();
+		post_event(EVENT_TYPE::AUDIO_DMA_DONE, start);
+	}
+#endif
+}
+
+// audio jack ADC DMA callbacks, each half of the buffer is a block for the audio task
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc){
+	uint32_t start = DWT->CYCCNT;
+	if(hadc == &hadc1 && jack.handle_dma_cb()){
+		post_event(EVENT_TYPE::AUX_BLOCK, start);
+	}
 }
 
-// callback to determine when the ADC read completes
+// also the end of conversion interrupt when passthrough latency is being measured
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc){
-	if(hadc == &hadc1){
-		uint32_t adc_val = HAL_ADC_GetValue(hadc);
-		uint32_t ccr = (static_cast<float>(adc_val) / static_cast<float>(MAX_ADC_VAL)) * htim2.Instance->ARR;
-		htim2.Instance->CCR1 = ccr;
+	uint32_t start = DWT->CYCCNT;
+	if(hadc == &hadc1 && jack.handle_dma_cb()){
+		post_event(EVENT_TYPE::AUX_BLOCK, start);
 	}
 }
 
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
-{
-	if (htim == &htim3) {
-		static float prev_z = 0;
-		static constexpr float alpha = 0.3;
+// touch controller PENIRQ and the FPGA asking for more samples
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
+	uint32_t start = DWT->CYCCNT;
+	if(GPIO_Pin == GPIO_PIN_7){
+		touch.handle_penirq();
+		post_event(EVENT_TYPE::TOUCH_PENIRQ, start);
+	}else if(GPIO_Pin == A_DRQ_Pin){
+		post_event(EVENT_TYPE::AUDIO_DRQ, start);
+	}
+}
+
+// SPI2 DMA callback when a touch burst has been read
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi){
+	uint32_t start = DWT->CYCCNT;
+	if(hspi == &hspi2){
+		touch.handle_dma_cb();
+		post_event(EVENT_TYPE::TOUCH_DMA_DONE, start);
+	}
+}
 
-		// frame rate controls
-		static constexpr unsigned long TICKS_PER_FRAME = 500;
-		static unsigned long last_interrupt_time = 0;
-		unsigned long interrupt_time = HAL_GetTick();
+// the pixy RX DMA is circular, this fires when the line goes idle after a response and at the half and full
+// marks of the ring
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size){
+	uint32_t start = DWT->CYCCNT;
+	if(huart == &huart2){
+		gimbal.handle_rx_event();
+		post_event(EVENT_TYPE::UART_RX, start);
+	}
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart){
+	uint32_t start = DWT->CYCCNT;
+	if(huart == &huart2)
+		post_event(EVENT_TYPE::UART_ERROR, start);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+	uint32_t start = DWT->CYCCNT;
+	if(huart == &huart2)
+		post_event(EVENT_TYPE::UART_TX_DONE, start);
+}
+
+// I2C1 callbacks for the LED channel, the next queued command starts from here
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c){
+	if(hi2c == &hi2c1)
+		leds.handle_tx_cb();
+}
 
-		uint16_t touch_x;
-		uint16_t touch_y;
-		uint16_t touch_z;
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c){
+	if(hi2c == &hi2c1)
+		leds.handle_rx_cb();
+}
 
-		screen.sample_x_y(&touch_x, &touch_y, &touch_z);
-		prev_z = alpha * touch_z + (1 - alpha) * prev_z;
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+	if(hi2c == &hi2c1)
+		leds.handle_error_cb();
+}
 
-		printf("Sampled %u %u %u\r\n", touch_x, touch_y, touch_z);
+// SPI3 DMA callback when an LVGL flush has been sent, SPI2 when a chunk of samples reached the FPGA
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){
+	uint32_t start = DWT->CYCCNT;
+#if USE_LVGL_UI
+	if(hspi == &hspi3)
+		lvgl.handle_dma_cb();
+#endif
+#if USE_FPGA_AUDIO
+	if(hspi == &hspi2){
+		audio_out.handle_dma_cb();
+		post_event(EVENT_TYPE::AUDIO_DMA_DONE, start);
+	}
+#endif
+	(void)start;
+}
 
-		screen.check_buttons(touch_x, touch_y, prev_z);
-		last_interrupt_time = interrupt_time;
-	} else if (htim == &htim5) {
-		send_req = true;
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+	uint32_t start = DWT->CYCCNT;
+	if (htim == &htim5) {
+		post_event(EVENT_TYPE::CAMERA_TICK, start);
+	} else if (htim == &htim4) {
+		gimbal.handle_servo_tick();
 	}
 }
 
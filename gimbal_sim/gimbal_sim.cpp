@@ -0,0 +1,404 @@
+// Runs the firmware's Gimbal unmodified against a simulated Pixy and servos, to tune and compare tracking
+// changes without the hardware. Build and run from this folder:
+//   g++ -std=gnu++17 -O2 -I. -I../fw/hearmeout/Core/Inc gimbal_sim.cpp -o gimbal_sim && ./gimbal_sim
+// Passing a scenario name prints its trace as CSV instead of the summary:
+//   ./gimbal_sim walk > walk.csv
+
+#include "main.h"
+#include "gimbal.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+DWT_Type sim_dwt;
+uint32_t SystemCoreClock = 1000000000;
+
+// world, all positions are servo pulses in us so they compare directly with the CCR values
+static constexpr double HOME_US = 1500;
+static constexpr double PAN_US_PER_PX = 0.667; // the defaults in Gimbal::init(), scenarios can scale the real ones
+static constexpr double TILT_US_PER_PX = 0.483;
+static constexpr double CENTER_X = 157.5;
+static constexpr double CENTER_Y = 103.5;
+static constexpr int FRAME_W = 316;
+static constexpr int FRAME_H = 208;
+
+static constexpr uint32_t CAMERA_TICK_MS = 10; // TIM5
+static constexpr uint32_t SERVO_PERIOD_US = 2500; // TIM4
+static constexpr uint32_t UART_BYTES_PER_MS = 11; // 115200 baud
+static constexpr double SETTLE_PX = 5;
+static constexpr uint32_t RUN_MS = 6000;
+static constexpr uint32_t STEADY_MS = 2000; // error stats cover the end of the run
+static constexpr uint32_t CAL_START_MS = 1000; // lets the gimbal find the listener first
+static constexpr uint32_t CAL_TIMEOUT_MS = 20000;
+
+// a listener in front of the speaker
+struct Listener {
+	double pan;
+	double tilt;
+	uint16_t w, h;
+	uint8_t idx;
+	bool visible;
+};
+
+struct Scenario {
+	char const* name;
+	std::function<void(uint32_t, std::vector<Listener>&)> move; // places the listeners at time t, the first is the target
+	double noise_px; // camera jitter, standard deviation
+	double dropout; // chance a frame misses the target
+	uint32_t latency_ms; // from the exposure until the frame can be read out
+	double camera_scale; // real servo travel per pixel over what the firmware assumes, a different lens or mount
+	bool calibrate; // runs Gimbal::calibrate() with a still target before the scenario starts
+};
+
+// hobby servo: moves toward the pulse it is given at a limited rate and ignores changes inside its deadband
+struct ServoMotor {
+	double pos;
+	double rate_us_per_ms;
+	double deadband_us;
+
+	void update(double cmd){
+		double diff = cmd - pos;
+		if(std::fabs(diff) <= deadband_us){
+			return;
+		}
+		if(diff > rate_us_per_ms) diff = rate_us_per_ms;
+		if(diff < -rate_us_per_ms) diff = -rate_us_per_ms;
+		pos += diff;
+	}
+};
+
+// Pixy2 at 60 fps answering getBlocks with the newest frame it has finished, or BUSY if that one was already sent
+struct Camera {
+	static constexpr double FRAME_MS = 1000.0 / 60;
+
+	std::mt19937 rng{373};
+	double next_exposure = 0;
+	std::deque<std::pair<uint32_t, std::vector<uint8_t>>> processing; // payloads with the time they are ready
+	std::vector<uint8_t> latest; // block payload of the newest ready frame
+	bool fresh = false; // latest has not been sent yet
+	uint32_t busy = 0;
+	uint8_t ages[256] = {};
+
+	void expose(uint32_t now, Scenario const& s, std::vector<Listener> const& listeners, ServoMotor const& pan, ServoMotor const& tilt){
+		if(now < next_exposure){
+			return;
+		}
+		next_exposure += FRAME_MS;
+
+		std::normal_distribution<double> noise(0, s.noise_px);
+		std::uniform_real_distribution<double> chance(0, 1);
+		std::vector<uint8_t> payload;
+		for(size_t i = 0; i < listeners.size(); ++i){
+			Listener const& l = listeners[i];
+			// the pan servo moves the view left for a longer pulse, tilt moves it down
+			double x = CENTER_X - (l.pan - pan.pos) / (PAN_US_PER_PX * s.camera_scale) + noise(rng);
+			double y = CENTER_Y + (l.tilt - tilt.pos) / (TILT_US_PER_PX * s.camera_scale) + noise(rng);
+			bool seen = l.visible && x >= 0 && x < FRAME_W && y >= 0 && y < FRAME_H && !(i == 0 && chance(rng) < s.dropout);
+			if(!seen){
+				ages[l.idx] = 0;
+				continue;
+			}
+			if(ages[l.idx] < 255) ++ages[l.idx];
+			uint16_t fields[6] = {1, static_cast<uint16_t>(x), static_cast<uint16_t>(y), l.w, l.h, 0};
+			for(uint16_t f : fields){
+				payload.push_back(f & 0xFF);
+				payload.push_back(f >> 8);
+			}
+			payload.push_back(l.idx);
+			payload.push_back(ages[l.idx]);
+		}
+		processing.push_back({now + s.latency_ms, payload});
+	}
+
+	void update(uint32_t now){
+		while(!processing.empty() && processing.front().first <= now){
+			latest = processing.front().second;
+			processing.pop_front();
+			fresh = true;
+		}
+	}
+
+	// the getBlocks response for the newest frame, at most max_blocks blocks
+	std::vector<uint8_t> response(uint8_t max_blocks){
+		if(!fresh){
+			++busy;
+			// result -2, little endian, checksum 0xFE + 3 * 0xFF
+			return {0xAF, 0xC1, 0x03, 0x04, 0xFB, 0x03, 0xFE, 0xFF, 0xFF, 0xFF};
+		}
+		fresh = false;
+		size_t len = std::min<size_t>(latest.size(), max_blocks * 14);
+		uint16_t sum = 0;
+		for(size_t i = 0; i < len; ++i) sum += latest[i];
+		std::vector<uint8_t> r = {0xAF, 0xC1, 0x21, static_cast<uint8_t>(len), static_cast<uint8_t>(sum & 0xFF), static_cast<uint8_t>(sum >> 8)};
+		r.insert(r.end(), latest.begin(), latest.begin() + len);
+		return r;
+	}
+};
+
+// simulator state the HAL stubs reach
+static uint32_t sim_now;
+static Camera* sim_camera;
+static uint8_t* rx_buf;
+static uint16_t rx_size;
+static uint16_t rx_pos;
+static std::deque<uint8_t> rx_line; // bytes on their way over the UART
+static bool rx_idle_event;
+static uint32_t requests;
+
+uint32_t HAL_GetTick(void){
+	return sim_now;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef*, uint32_t){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef*){
+	return HAL_OK;
+}
+
+// the camera answers as soon as the request is in, with whatever frame it has ready
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef*, uint8_t const* data, uint16_t size){
+	if(!rx_line.empty()){
+		return HAL_BUSY;
+	}
+	++requests;
+	std::vector<uint8_t> r = sim_camera->response(size == 6 ? data[5] : 1);
+	rx_line.insert(rx_line.end(), r.begin(), r.end());
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size){
+	rx_buf = data;
+	rx_size = size;
+	rx_pos = 0;
+	huart->hdmarx->counter = size;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef*){
+	return HAL_OK;
+}
+
+// one ms worth of bytes into the circular buffer, true if the DMA would have raised an event
+static bool uart_update(UART_HandleTypeDef* huart){
+	bool event = false;
+	for(uint32_t i = 0; i < UART_BYTES_PER_MS && !rx_line.empty(); ++i){
+		rx_buf[rx_pos] = rx_line.front();
+		rx_line.pop_front();
+		rx_pos = (rx_pos + 1) % rx_size;
+		if(rx_pos == 0 || rx_pos == rx_size / 2){
+			event = true;
+		}
+		rx_idle_event = true;
+	}
+	huart->hdmarx->counter = rx_size - rx_pos;
+	if(rx_line.empty() && rx_idle_event){
+		rx_idle_event = false;
+		event = true;
+	}
+	return event;
+}
+
+static Listener listener(double pan, double tilt, uint16_t size, uint8_t idx){
+	return {pan, tilt, size, size, idx, true};
+}
+
+struct Result {
+	double settle_ms; // negative if the error never stayed inside SETTLE_PX
+	double mean_err_px;
+	double jitter_px;
+	double step_ns;
+	double max_step_ns;
+	double rx_ns;
+	double max_rx_ns;
+	uint32_t requests_per_s;
+	uint32_t busy_per_s;
+};
+
+static Result run(Scenario const& s, bool trace){
+	Gimbal gimbal;
+	DMA_HandleTypeDef dma = {0};
+	UART_HandleTypeDef uart = {&dma};
+	TIM_TypeDef servo_regs = {0};
+	TIM_HandleTypeDef servo_tim = {&servo_regs, {119, 2499}, {0}}; // 400 Hz, 1 count per us
+	TIM_HandleTypeDef cam_tim = {nullptr, {999, 9999}, {0}}; // 10 ms at the simulated 1 GHz
+
+	Camera camera;
+	sim_camera = &camera;
+	sim_now = 0;
+	rx_line.clear();
+	rx_idle_event = false;
+	requests = 0;
+
+	ServoMotor pan = {HOME_US, 6.0, 1.0}; // about 0.1 s per 60 degrees
+	ServoMotor tilt = {HOME_US, 6.0, 1.0};
+	std::vector<Listener> listeners;
+
+	gimbal.init(&servo_tim, &cam_tim, &uart);
+	gimbal.request_pos();
+
+	std::vector<double> err;
+	double step_ns = 0, max_step_ns = 0, rx_ns = 0, max_rx_ns = 0;
+	uint32_t steps = 0, rxs = 0;
+	uint32_t servo_us = 0; // time since the last TIM4 update
+
+	// one ms of the world and the firmware, the same order as the interrupts and tasks on the board
+	auto simulate = [&](std::vector<Listener>& l){
+		camera.expose(sim_now, s, l, pan, tilt);
+		camera.update(sim_now);
+
+		if(uart_update(&uart)){
+			auto start = std::chrono::steady_clock::now();
+			gimbal.handle_rx_event();
+			gimbal.process_rx();
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			rx_ns += ns;
+			max_rx_ns = std::max(max_rx_ns, ns);
+			++rxs;
+		}
+
+		if(sim_now % CAMERA_TICK_MS == 0){
+			auto start = std::chrono::steady_clock::now();
+			gimbal.control_step(sim_now);
+			gimbal.check_request(sim_now);
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			step_ns += ns;
+			max_step_ns = std::max(max_step_ns, ns);
+			++steps;
+		}
+
+		for(servo_us += 1000; servo_us >= SERVO_PERIOD_US; servo_us -= SERVO_PERIOD_US){
+			gimbal.handle_servo_tick();
+		}
+		pan.update(servo_tim.ccr[TIM_CHANNEL_2 / 4]);
+		tilt.update(servo_tim.ccr[TIM_CHANNEL_1 / 4]);
+	};
+
+	if(s.calibrate){
+		// a listener standing still near the middle, found first and then measured
+		std::vector<Listener> still = {listener(HOME_US + 10, HOME_US - 5, 40, 1)};
+		for(; sim_now < CAL_TIMEOUT_MS && !gimbal.is_calibrating(); ++sim_now){
+			simulate(still);
+			if(sim_now >= CAL_START_MS){
+				gimbal.calibrate();
+			}
+		}
+		for(; sim_now < CAL_TIMEOUT_MS && gimbal.is_calibrating(); ++sim_now){
+			simulate(still);
+		}
+		Gimbal::Calibration cal;
+		if(!gimbal.take_calibration(&cal)){
+			fprintf(stderr, "%s: calibration failed\n", s.name);
+		}
+		steps = rxs = 0;
+		step_ns = max_step_ns = rx_ns = max_rx_ns = 0;
+	}
+
+	uint32_t t0 = sim_now;
+	requests = 0;
+	camera.busy = 0;
+	if(trace){
+		printf("t_ms,target_pan,target_tilt,servo_pan,servo_tilt,cmd_pan,cmd_tilt,err_px\n");
+	}
+	for(uint32_t t = 0; t < RUN_MS; ++t, ++sim_now){
+		s.move(t, listeners);
+		simulate(listeners);
+
+		double ex = (listeners[0].pan - pan.pos) / (PAN_US_PER_PX * s.camera_scale);
+		double ey = (listeners[0].tilt - tilt.pos) / (TILT_US_PER_PX * s.camera_scale);
+		err.push_back(std::sqrt(ex * ex + ey * ey));
+		if(trace){
+			printf("%u,%.1f,%.1f,%.1f,%.1f,%u,%u,%.2f\n", sim_now - t0, listeners[0].pan, listeners[0].tilt,
+					pan.pos, tilt.pos, servo_tim.ccr[TIM_CHANNEL_2 / 4], servo_tim.ccr[TIM_CHANNEL_1 / 4], err.back());
+		}
+	}
+
+	Result r;
+	r.settle_ms = -1;
+	for(int t = RUN_MS - 1; t >= 0; --t){
+		if(err[t] > SETTLE_PX){
+			r.settle_ms = t + 1 < static_cast<int>(RUN_MS) ? t + 1 : -1;
+			break;
+		}
+		if(t == 0) r.settle_ms = 0;
+	}
+	double sum = 0, sum_sq = 0;
+	for(uint32_t t = RUN_MS - STEADY_MS; t < RUN_MS; ++t){
+		sum += err[t];
+		sum_sq += err[t] * err[t];
+	}
+	r.mean_err_px = sum / STEADY_MS;
+	r.jitter_px = std::sqrt(std::max(0.0, sum_sq / STEADY_MS - r.mean_err_px * r.mean_err_px));
+	r.step_ns = steps ? step_ns / steps : 0;
+	r.max_step_ns = max_step_ns;
+	r.rx_ns = rxs ? rx_ns / rxs : 0;
+	r.max_rx_ns = max_rx_ns;
+	r.requests_per_s = requests * 1000 / RUN_MS;
+	r.busy_per_s = camera.busy * 1000 / RUN_MS;
+	return r;
+}
+
+
+static std::vector<Scenario> scenarios(){
+	return {
+		{"step", [](uint32_t, std::vector<Listener>& l){
+			l = {listener(HOME_US + 80, HOME_US - 30, 40, 1)};
+		}, 0.5, 0, 20, 1.0, false},
+		{"step_noisy", [](uint32_t, std::vector<Listener>& l){
+			l = {listener(HOME_US + 80, HOME_US - 30, 40, 1)};
+		}, 2.0, 0.2, 40, 1.0, false},
+		{"walk", [](uint32_t t, std::vector<Listener>& l){
+			// across the room at about a walking pace and back
+			double p = t < 3000 ? t * 0.05 : (6000 - t) * 0.05;
+			l = {listener(HOME_US - 75 + p, HOME_US, 40, 1)};
+		}, 0.5, 0.05, 20, 1.0, false},
+		{"sway", [](uint32_t t, std::vector<Listener>& l){
+			l = {listener(HOME_US + 40 * std::sin(2 * M_PI * 0.5 * t / 1000.0), HOME_US + 15 * std::sin(2 * M_PI * 0.3 * t / 1000.0), 40, 1)};
+		}, 0.5, 0.05, 20, 1.0, false},
+		{"two_listeners", [](uint32_t t, std::vector<Listener>& l){
+			// a bigger listener walks into view while the first one is followed
+			l = {listener(HOME_US + 30, HOME_US, 30, 1), listener(HOME_US - 40, HOME_US + 10, 60, 2)};
+			l[1].visible = t > 2000;
+		}, 1.0, 0.05, 20, 1.0, false},
+		{"miscal_step", [](uint32_t, std::vector<Listener>& l){
+			// a wider lens than the defaults were worked out for
+			l = {listener(HOME_US + 80, HOME_US - 30, 40, 1)};
+		}, 0.5, 0, 20, 1.6, false},
+		{"cal_step", [](uint32_t, std::vector<Listener>& l){
+			l = {listener(HOME_US + 80, HOME_US - 30, 40, 1)};
+		}, 0.5, 0, 20, 1.6, true},
+	};
+}
+
+int main(int argc, char** argv){
+	std::vector<Scenario> list = scenarios();
+
+	if(argc > 1){
+		for(Scenario const& s : list){
+			if(strcmp(s.name, argv[1]) == 0){
+				run(s, true);
+				return 0;
+			}
+		}
+		fprintf(stderr, "Unknown scenario %s\n", argv[1]);
+		return 1;
+	}
+
+	printf("%-14s %9s %9s %9s %10s %10s %10s %10s %6s %6s\n", "scenario", "settle_ms", "err_px", "jitter_px",
+			"step_ns", "max_ns", "rx_ns", "max_ns", "req/s", "busy/s");
+	for(Scenario const& s : list){
+		Result r = run(s, false);
+		char settle[16];
+		if(r.settle_ms < 0) snprintf(settle, sizeof(settle), "-");
+		else snprintf(settle, sizeof(settle), "%.0f", r.settle_ms);
+		printf("%-14s %9s %9.2f %9.2f %10.0f %10.0f %10.0f %10.0f %6u %6u\n", s.name, settle, r.mean_err_px, r.jitter_px,
+				r.step_ns, r.max_step_ns, r.rx_ns, r.max_rx_ns, r.requests_per_s, r.busy_per_s);
+	}
+	return 0;
+}
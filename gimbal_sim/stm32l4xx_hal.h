@@ -0,0 +1,71 @@
+// Just enough of the STM32 HAL for gimbal.hpp to build on the host, picked up through the firmware's main.h
+// (inside its extern "C", so only C headers here).
+// The functions are implemented by the simulator. DWT->CYCCNT counts host nanoseconds and SystemCoreClock is
+// 1 GHz to match, so the firmware's cycle stats come out in ns.
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+typedef enum {
+	HAL_OK = 0x00,
+	HAL_ERROR = 0x01,
+	HAL_BUSY = 0x02,
+	HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+typedef struct {
+	uint32_t counter; // bytes left before the circular buffer wraps
+} DMA_HandleTypeDef;
+
+typedef struct {
+	DMA_HandleTypeDef* hdmarx;
+} UART_HandleTypeDef;
+
+typedef struct {
+	uint32_t Prescaler;
+	uint32_t Period;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+	uint32_t CR1;
+} TIM_TypeDef;
+
+typedef struct {
+	TIM_TypeDef* Instance;
+	TIM_Base_InitTypeDef Init;
+	uint32_t ccr[4];
+} TIM_HandleTypeDef;
+
+struct sim_cyccnt {
+	operator uint32_t() const {
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return static_cast<uint32_t>(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+	}
+};
+
+typedef struct {
+	sim_cyccnt CYCCNT;
+} DWT_Type;
+
+extern DWT_Type sim_dwt;
+#define DWT (&sim_dwt)
+
+extern uint32_t SystemCoreClock;
+
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CR1_UDIS 0x00000002U
+#define SET_BIT(reg, bit) ((reg) |= (bit))
+#define CLEAR_BIT(reg, bit) ((reg) &= ~(bit))
+#define __HAL_TIM_GET_AUTORELOAD(htim) ((htim)->Init.Period)
+#define __HAL_TIM_SET_COMPARE(htim, channel, compare) ((htim)->ccr[(channel) / 4] = (compare))
+#define __HAL_DMA_GET_COUNTER(hdma) ((hdma)->counter)
+
+uint32_t HAL_GetTick(void);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef* htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* htim);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef* huart, uint8_t const* data, uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef* huart);
@@ -0,0 +1,178 @@
+// Sample FIFO fed over SPI by the MCU and the ultrasonic carrier for the transducer driver
+//
+// DIR is a square wave at the sample rate. EN is a PWM at twice that, one pulse per DIR half, and its
+// duty follows the sample. The duty is worked out with a first order sigma-delta so the part of the
+// sample below one clock of pulse width is carried into the next pulse instead of being dropped.
+module audio_out #(
+    parameter CLK_HZ = 25_000_000,
+    parameter SAMPLE_HZ = 40_000,
+    parameter FIFO_BITS = 10 // 1024 samples
+)(
+    input clk,
+    input rst_n,
+
+    // SPI mode 0 from the MCU, signed 16 bit samples sent low byte first, each byte msb first
+    input sck_i,
+    input mosi_i,
+    input cs_n_i,
+
+    output logic drq, // FIFO at most half full, the MCU may send up to half a FIFO
+    output logic dir,
+    output logic en,
+
+    output logic [7:0] underruns, // times the FIFO ran dry while playing, saturates
+    output logic [7:0] level      // FIFO fill / 4, saturates
+);
+    localparam SAMPLE_DIV = CLK_HZ / SAMPLE_HZ;
+    localparam HALF_A = (SAMPLE_DIV + 1) / 2; // clocks in the first DIR half
+    localparam HALF_B = SAMPLE_DIV - HALF_A;
+    localparam FIFO_DEPTH = 1 << FIFO_BITS;
+
+    // two flop synchronizers, sck gets a third so its edge is found from two settled samples
+    logic [2:0] sck_sync;
+    logic [1:0] mosi_sync;
+    logic [1:0] cs_sync;
+    always_ff @(posedge clk) begin
+        if(~rst_n) begin
+            sck_sync <= '0;
+            mosi_sync <= '0;
+            cs_sync <= '1;
+        end else begin
+            sck_sync <= {sck_sync[1:0], sck_i};
+            mosi_sync <= {mosi_sync[0], mosi_i};
+            cs_sync <= {cs_sync[0], cs_n_i};
+        end
+    end
+
+    logic sck_rise;
+    assign sck_rise = sck_sync[2:1] == 2'b01;
+
+    // SPI slave, a word is written to the FIFO after every 16 bits
+    logic [3:0] spi_bit;
+    logic [6:0] spi_shift;
+    logic [7:0] spi_low;
+    logic wr_en;
+    logic [15:0] wr_data;
+    always_ff @(posedge clk) begin
+        if(~rst_n) begin
+            spi_bit <= '0;
+            spi_shift <= '0;
+            spi_low <= '0;
+            wr_en <= '0;
+            wr_data <= '0;
+        end else begin
+            wr_en <= '0;
+            if(cs_sync[1]) begin
+                // a transfer always starts on a sample boundary
+                spi_bit <= '0;
+            end else if(sck_rise) begin
+                spi_shift <= {spi_shift[5:0], mosi_sync[1]};
+                spi_bit <= spi_bit + 'd1;
+                if(spi_bit == 'd7) begin
+                    spi_low <= {spi_shift, mosi_sync[1]};
+                end else if(spi_bit == 'd15) begin
+                    wr_data <= {spi_shift, mosi_sync[1], spi_low};
+                    wr_en <= 1'b1;
+                end
+            end
+        end
+    end
+
+    // FIFO, the memory has a registered read so it fits block RAM
+    logic [15:0] mem [0:FIFO_DEPTH-1];
+    logic [FIFO_BITS:0] wr_ptr, rd_ptr;
+    logic [FIFO_BITS:0] fill;
+    logic [15:0] rd_data;
+    logic empty_q; // one clock late so a word written last clock has made it through the read register
+    logic pop;
+    assign fill = wr_ptr - rd_ptr;
+
+    always_ff @(posedge clk) begin
+        // words that arrive while full are dropped, the MCU only sends when drq allows it
+        if(wr_en && fill != FIFO_DEPTH) begin
+            mem[wr_ptr[FIFO_BITS-1:0]] <= wr_data;
+        end
+        rd_data <= mem[rd_ptr[FIFO_BITS-1:0]];
+    end
+
+    always_ff @(posedge clk) begin
+        if(~rst_n) begin
+            wr_ptr <= '0;
+            rd_ptr <= '0;
+            empty_q <= 1'b1;
+        end else begin
+            if(wr_en && fill != FIFO_DEPTH) begin
+                wr_ptr <= wr_ptr + 'd1;
+            end
+            if(pop) begin
+                rd_ptr <= rd_ptr + 'd1;
+            end
+            empty_q <= fill == 0;
+        end
+    end
+
+    assign drq = fill <= FIFO_DEPTH / 2;
+    assign level = (fill >> 2) > 'd255 ? 8'hFF : 8'(fill >> 2);
+
+    // sample clock and carrier
+    logic [$clog2(SAMPLE_DIV)-1:0] phase;
+    logic tick; // last clock of a sample, the next sample's first pulse is set up here
+    logic half; // last clock of the first DIR half
+    assign tick = phase == SAMPLE_DIV - 1;
+    assign half = phase == HALF_A - 1;
+    assign pop = tick && ~empty_q;
+
+    logic [15:0] sample; // offset binary, 0 keeps EN off
+    logic playing;
+    logic [15:0] err; // pulse width below one clock, carried to the next pulse
+    logic [$clog2(HALF_A+1)-1:0] duty;
+
+    // sample * half length + carried error, the top bits are whole clocks of pulse
+    logic [15+$clog2(HALF_A+1):0] acc_a, acc_b;
+    logic [15:0] next_sample;
+    assign next_sample = ~empty_q ? {~rd_data[15], rd_data[14:0]} : 16'h0000;
+    assign acc_a = next_sample * HALF_A + err;
+    assign acc_b = sample * HALF_B + err;
+
+    always_ff @(posedge clk) begin
+        if(~rst_n) begin
+            phase <= '0;
+            sample <= '0;
+            playing <= '0;
+            underruns <= '0;
+            err <= '0;
+            duty <= '0;
+            dir <= '0;
+            en <= '0;
+        end else begin
+            phase <= tick ? '0 : phase + 'd1;
+
+            if(tick) begin
+                sample <= next_sample;
+                duty <= acc_a[15+$clog2(HALF_A+1):16];
+                err <= acc_a[15:0];
+                if(empty_q) begin
+                    // the carrier goes quiet until the MCU sends more
+                    if(playing && underruns != 8'hFF) begin
+                        underruns <= underruns + 'd1;
+                    end
+                    playing <= 1'b0;
+                end else begin
+                    playing <= 1'b1;
+                end
+            end else if(half) begin
+                duty <= acc_b[15+$clog2(HALF_A+1):16];
+                err <= acc_b[15:0];
+            end
+
+            // registered so the pins never glitch, each DIR half starts with its EN pulse
+            dir <= phase < HALF_A;
+            if(phase < HALF_A) begin
+                en <= phase < duty;
+            end else begin
+                en <= phase - HALF_A < duty;
+            end
+        end
+    end
+
+endmodule
@@ -16,7 +16,7 @@ OSCZ osc_inst (
     .OSCEN(oscen)
 );
 
-defparam osc_inst.FREQ_DIV = 128;
+defparam osc_inst.FREQ_DIV = 10;
 defparam osc_inst.S_RATE = "SLOW";
 
 endmodule //Gowin_OSC
@@ -1,5 +1,33 @@
 localparam ADDRESS = 69;
 
+// OSCZ is 250MHz / FREQ_DIV, fast enough to sample a 1MHz Fast-mode Plus bus several times per half period
+localparam CLK_HZ = 250_000_000 / 10;
+
+// register map, the first data byte of a write sets the register pointer and every byte after it
+// is written to the pointer, which then increments
+localparam REG_R     = 8'h00;
+localparam REG_G     = 8'h01;
+localparam REG_B     = 8'h02;
+localparam REG_MODE  = 8'h03;
+localparam REG_LATCH = 8'h04; // writing bit 0 copies R, G, B and MODE to the outputs together
+localparam REG_PERIOD = 8'h05; // animation speed, applies right away
+localparam REG_LEVEL = 8'h06; // meter input, applies right away
+localparam REG_STATUS = 8'h07; // read only, bits 2-0 are set while that channel is lit, bits 7-4 are the mode
+localparam REG_ID    = 8'h08; // read only
+localparam REG_AUDIO_UNDERRUNS = 8'h09; // read only, times the audio FIFO ran dry while playing
+localparam REG_AUDIO_LEVEL = 8'h0A; // read only, audio FIFO fill / 4
+localparam NUM_REGS  = 11;
+
+localparam ID = 8'h4C;
+
+// animations, all of them scale the latched colour by an envelope
+localparam MODE_STATIC  = 8'h00;
+localparam MODE_BREATHE = 8'h01; // triangle fade in and out over 512 * (PERIOD + 1) ms
+localparam MODE_BLINK   = 8'h02; // on and off, same cycle length as breathe
+localparam MODE_METER   = 8'h03; // jumps up to LEVEL and falls back one step every PERIOD + 1 ms
+
+localparam ANIM_TICK_HZ = 1000;
+
 module i2c_led(
     input btn_a,
     input sda_i,
@@ -12,6 +40,14 @@ module i2c_led(
     output logic led_g,
     output logic led_b,
 
+    // sample stream from the MCU and the transducer driver outputs
+    input aud_sck,
+    input aud_mosi,
+    input aud_cs_n,
+    output logic aud_drq,
+    output logic aud_dir,
+    output logic aud_en,
+
     // DEBUG //
     output logic state0,
     output logic state1,
@@ -29,23 +65,47 @@ module i2c_led(
         .oscen(1'b1)
     );
 
+    logic [7:0] audio_underruns, audio_level;
+    audio_out #(
+        .CLK_HZ(CLK_HZ)
+    ) audio (
+        .clk(clk),
+        .rst_n(btn_a),
+        .sck_i(aud_sck),
+        .mosi_i(aud_mosi),
+        .cs_n_i(aud_cs_n),
+        .drq(aud_drq),
+        .dir(aud_dir),
+        .en(aud_en),
+        .underruns(audio_underruns),
+        .level(audio_level)
+    );
+
     // state machine
-    logic [1:0] state, next_state;
+    localparam ST_IDLE    = 2'b00;
+    localparam ST_ADDRESS = 2'b01;
+    localparam ST_DATA    = 2'b10;
+    localparam ST_READ    = 2'b11;
+    logic [1:0] state;
 
-    // detect the positive and negative edge of the sda and scl
-    logic prev_sda, sda;
-    logic prev_scl, scl;
+    // two flop synchronizers, then detect the positive and negative edge of the sda and scl
+    logic sda_meta, prev_sda, sda;
+    logic scl_meta, prev_scl, scl;
     always_ff @(posedge clk) begin
         if(~btn_a) begin
-            sda <= '0;
-            scl <= '0;
-            prev_sda <= '0;
-            prev_scl <= '0;
+            sda_meta <= '1;
+            scl_meta <= '1;
+            sda <= '1;
+            scl <= '1;
+            prev_sda <= '1;
+            prev_scl <= '1;
         end else begin
+            sda_meta <= sda_i;
+            scl_meta <= scl_i;
             prev_sda <= sda;
             prev_scl <= scl;
-            sda <= sda_i;
-            scl <= scl_i;
+            sda <= sda_meta;
+            scl <= scl_meta;
         end
     end
 
@@ -58,134 +118,303 @@ module i2c_led(
     assign rising_scl  = ~prev_scl && scl;
     assign falling_scl = prev_scl && ~scl;
 
-    // read the address
-    logic [6:0] address, next_address;
-    logic [3:0] address_bits_read, next_address_bits_read;
-    logic address_eq;
-    assign address_eq = address == ADDRESS;
-    assign next_address = {address[5:0], sda};
-    assign next_address_bits_read = address_bits_read + 'd1;
+    // sda only changes while scl is low, except for these two, scl has to have been high for two samples so
+    // a data change right after the falling edge can not look like one
+    logic start_cond, stop_cond;
+    assign start_cond = falling_sda && scl && prev_scl; // also a repeated start
+    assign stop_cond  = rising_sda && scl && prev_scl;
+
+    // bits 0-7 are shifted in on rising scl, 8 is the ack bit
+    logic [7:0] shift;
+    logic [3:0] bit_cnt;
+    logic byte_done, ack_done;
+    assign byte_done = falling_scl && bit_cnt == 'd8;
+    assign ack_done  = falling_scl && bit_cnt == 'd9;
+
+    // data bytes seen since the address, the first one is the register pointer or a legacy opcode
+    logic first_byte;
+    logic [7:0] pointer;
+
+    // registers written over I2C
+    logic [7:0] reg_r, reg_g, reg_b, reg_mode;
+    // values the outputs are driven from, only change on a latch or a legacy opcode
+    logic [7:0] out_r, out_g, out_b, out_mode;
+    logic [7:0] period, level;
+
+    // read side, a byte is shifted out msb first starting on the falling edge after the ack
+    logic reading; // r/w bit of the address
+    logic [7:0] tx_shift;
+    logic [7:0] read_data;
+    logic [7:0] status;
+    always_comb begin
+        case (pointer)
+            REG_R:      read_data = reg_r;
+            REG_G:      read_data = reg_g;
+            REG_B:      read_data = reg_b;
+            REG_MODE:   read_data = reg_mode;
+            REG_PERIOD: read_data = period;
+            REG_LEVEL:  read_data = level;
+            REG_STATUS: read_data = status;
+            REG_ID:     read_data = ID;
+            REG_AUDIO_UNDERRUNS: read_data = audio_underruns;
+            REG_AUDIO_LEVEL: read_data = audio_level;
+            default:    read_data = 8'hFF;
+        endcase
+    end
 
     always_ff @(posedge clk) begin
         if(~btn_a) begin
-            address <= '0;
-            address_bits_read <= '0;
-        end else begin
-            if(state == 2'b01 && rising_scl) begin
-                // clock only the first seven bits into the address register
-                if(next_address_bits_read <= 7) begin
-                    address <= next_address;
+            state <= ST_IDLE;
+            shift <= '0;
+            bit_cnt <= '0;
+            sda_o <= '0;
+            first_byte <= '0;
+            pointer <= '0;
+            reading <= '0;
+            tx_shift <= '0;
+            reg_r <= '0;
+            reg_g <= '0;
+            reg_b <= '0;
+            reg_mode <= '0;
+            out_r <= '0;
+            out_g <= '0;
+            out_b <= '0;
+            out_mode <= '0;
+            period <= 'd3;
+            level <= '0;
+        end else if(start_cond) begin
+            state <= ST_ADDRESS;
+            bit_cnt <= '0;
+            sda_o <= '0;
+        end else if(stop_cond) begin
+            state <= ST_IDLE;
+            bit_cnt <= '0;
+            sda_o <= '0;
+        end else if(state == ST_READ) begin
+            // sda_o pulls the line low, so a 1 is sent by letting go. bits change on the falling edge, the
+            // master samples on the rising edge, nothing here ever holds scl
+            if(rising_scl && bit_cnt < 'd8) begin
+                bit_cnt <= bit_cnt + 'd1;
+            end else if(falling_scl && bit_cnt < 'd8) begin
+                sda_o <= ~tx_shift[6];
+                tx_shift <= {tx_shift[6:0], 1'b0};
+            end else if(falling_scl && bit_cnt == 'd8) begin
+                // let go for the master's ack
+                sda_o <= '0;
+            end else if(rising_scl && bit_cnt == 'd8) begin
+                // a nack ends the read, the master sends a stop or a repeated start next
+                if(sda) begin
+                    state <= ST_IDLE;
+                end
+                bit_cnt <= 'd9;
+            end else if(ack_done) begin
+                bit_cnt <= '0;
+                tx_shift <= read_data;
+                sda_o <= ~read_data[7];
+                if(pointer < NUM_REGS) begin
+                    pointer <= pointer + 'd1;
+                end
+            end
+        end else if(state != ST_IDLE) begin
+            if(rising_scl && bit_cnt < 'd8) begin
+                shift <= {shift[6:0], sda};
+                bit_cnt <= bit_cnt + 'd1;
+            end else if(byte_done) begin
+                bit_cnt <= 'd9;
+                if(state == ST_ADDRESS) begin
+                    // anything not for our address is ignored until the next start
+                    sda_o <= shift[7:1] == ADDRESS;
+                    reading <= shift[0];
+                    first_byte <= 1'b1;
                 end else begin
-                    address <= address;
+                    sda_o <= 1'b1;
+                    first_byte <= 1'b0;
+                    if(first_byte) begin
+                        // legacy opcodes leave the pointer past the map, so extra bytes are ignored
+                        pointer <= shift;
+                        // the original one byte opcodes, high nibble picks the LED and bit 0 turns it on
+                        case (shift)
+                            'h10: begin reg_r <= '0;  out_r <= '0;  end
+                            'h11: begin reg_r <= '1;  out_r <= '1;  end
+                            'h20: begin reg_g <= '0;  out_g <= '0;  end
+                            'h21: begin reg_g <= '1;  out_g <= '1;  end
+                            'h30: begin reg_b <= '0;  out_b <= '0;  end
+                            'h31: begin reg_b <= '1;  out_b <= '1;  end
+                            default: ;
+                        endcase
+                    end else begin
+                        case (pointer)
+                            REG_R: reg_r <= shift;
+                            REG_G: reg_g <= shift;
+                            REG_B: reg_b <= shift;
+                            REG_MODE: reg_mode <= shift;
+                            REG_LATCH: begin
+                                if(shift[0]) begin
+                                    out_r <= reg_r;
+                                    out_g <= reg_g;
+                                    out_b <= reg_b;
+                                    out_mode <= reg_mode;
+                                end
+                            end
+                            REG_PERIOD: period <= shift;
+                            REG_LEVEL: level <= shift;
+                            default: ;
+                        endcase
+                        // stops at the end of the map so a long burst can not wrap around into R
+                        if(pointer < NUM_REGS) begin
+                            pointer <= pointer + 'd1;
+                        end
+                    end
+                end
+            end else if(ack_done) begin
+                bit_cnt <= '0;
+                sda_o <= '0;
+                if(state == ST_ADDRESS) begin
+                    if(~sda_o) begin
+                        state <= ST_IDLE;
+                    end else if(reading) begin
+                        // the first bit goes out as soon as the ack is released
+                        state <= ST_READ;
+                        tx_shift <= read_data;
+                        sda_o <= ~read_data[7];
+                        if(pointer < NUM_REGS) begin
+                            pointer <= pointer + 'd1;
+                        end
+                    end else begin
+                        state <= ST_DATA;
+                    end
                 end
-
-                address_bits_read <= next_address_bits_read;
-            end else if(state != 2'b01) begin
-                address <= '0;
-                address_bits_read <= '0;
             end
         end
     end
 
-    // read the data
-    logic [7:0] data, next_data;
-    logic [3:0] data_bits_read, next_data_bits_read;
-    assign next_data = {data[6:0], sda};
-    assign next_data_bits_read = data_bits_read + 'd1;
+    // animation tick, envelope steps are counted in these
+    localparam ANIM_DIV = CLK_HZ / ANIM_TICK_HZ;
+    logic [$clog2(ANIM_DIV)-1:0] anim_div_cnt;
+    logic [7:0] anim_step_cnt;
+    logic anim_step; // one clock every PERIOD + 1 ticks
+    logic [8:0] phase; // breathe / blink position in the cycle
+    logic [7:0] meter;
 
     always_ff @(posedge clk) begin
         if(~btn_a) begin
-            data <= '0;
-            data_bits_read <= '0;
+            anim_div_cnt <= '0;
+            anim_step_cnt <= '0;
+            anim_step <= '0;
         end else begin
-            if(state == 2'b10 && rising_scl) begin
-                // clock only the first seven bits into the address register
-                if(next_data_bits_read <= 8) begin
-                    data <= next_data;
+            anim_step <= '0;
+            if(anim_div_cnt == ANIM_DIV - 1) begin
+                anim_div_cnt <= '0;
+                if(anim_step_cnt >= period) begin
+                    anim_step_cnt <= '0;
+                    anim_step <= 1'b1;
                 end else begin
-                    data <= data;
+                    anim_step_cnt <= anim_step_cnt + 'd1;
                 end
-
-                data_bits_read <= next_data_bits_read;
-            end else if(state != 2'b10) begin
-                data <= '0;
-                data_bits_read <= '0;
+            end else begin
+                anim_div_cnt <= anim_div_cnt + 'd1;
             end
         end
     end
 
     always_ff @(posedge clk) begin
-        // ack
-        if(btn_a && ((address_bits_read == 'd8 && state == 2'b01) || (data_bits_read == 'd8 && state == 2'b10)) && falling_scl) begin
-            sda_o <= 1'b1;
-        end else if (~btn_a || ((address_bits_read < 'd8 && state == 2'b01) || (data_bits_read < 'd8 && state == 2'b10) || state == 2'b00)) begin
-            sda_o <= '0;
+        if(~btn_a) begin
+            phase <= '0;
+            meter <= '0;
+        end else begin
+            if(anim_step) begin
+                phase <= phase + 'd1;
+            end
+            // peak follower, rises with the level at once and decays on the animation steps
+            if(level > meter) begin
+                meter <= level;
+            end else if(anim_step && meter != '0) begin
+                meter <= meter - 'd1;
+            end
         end
     end
 
+    logic [7:0] env;
     always_comb begin
-        case (state) 
-            2'b00: begin
-                next_state = (falling_sda && scl) ? 2'b01 : state;
-            end
-            2'b01: begin // (address_eq ? 2'b10 : 2'b00)
-                next_state = (falling_scl && address_bits_read == 'd9) ? (address_eq ? 2'b10 : 2'b00) : state;
-            end
-            2'b10: begin
-                next_state = (falling_scl && data_bits_read == 'd9) ? 2'b00 : state;
-            end
-            default: next_state = '0;
+        case (out_mode)
+            MODE_BREATHE: env = phase[8] ? ~phase[7:0] : phase[7:0];
+            MODE_BLINK:   env = phase[8] ? 8'h00 : 8'hFF;
+            MODE_METER:   env = meter;
+            default:      env = 8'hFF;
+        endcase
+    end
+
+    // one 8 bit PWM period is 256 clocks, the duty cycles for the next period are worked out at the start
+    // of the current one through a single shared multiplier: colour * envelope, then squared for gamma
+    logic [7:0] pwm_cnt;
+    logic [7:0] scaled_r, scaled_g, scaled_b;
+    logic [7:0] next_r, next_g, next_b;
+    logic [7:0] duty_r, duty_g, duty_b;
+
+    logic [7:0] mul_a, mul_b;
+    logic [15:0] mul_p;
+    always_comb begin
+        case (pwm_cnt)
+            'd0: begin mul_a = out_r; mul_b = env; end
+            'd1: begin mul_a = out_g; mul_b = env; end
+            'd2: begin mul_a = out_b; mul_b = env; end
+            'd3: begin mul_a = scaled_r; mul_b = scaled_r; end
+            'd4: begin mul_a = scaled_g; mul_b = scaled_g; end
+            'd5: begin mul_a = scaled_b; mul_b = scaled_b; end
+            default: begin mul_a = '0; mul_b = '0; end
         endcase
     end
+    // rounds up so anything that is not 0 stays at least 1, 255 * 255 stays 255
+    assign mul_p = mul_a * mul_b + 16'd255;
 
     always_ff @(posedge clk) begin
         if(~btn_a) begin
-            state <= 2'b00;
+            pwm_cnt <= '0;
+            scaled_r <= '0;
+            scaled_g <= '0;
+            scaled_b <= '0;
+            next_r <= '0;
+            next_g <= '0;
+            next_b <= '0;
+            duty_r <= '0;
+            duty_g <= '0;
+            duty_b <= '0;
         end else begin
-            state <= next_state;
+            pwm_cnt <= pwm_cnt + 'd1;
+            case (pwm_cnt)
+                'd0: scaled_r <= mul_p[15:8];
+                'd1: scaled_g <= mul_p[15:8];
+                'd2: scaled_b <= mul_p[15:8];
+                'd3: next_r <= mul_p[15:8];
+                'd4: next_g <= mul_p[15:8];
+                'd5: next_b <= mul_p[15:8];
+                'd255: begin
+                    duty_r <= next_r;
+                    duty_g <= next_g;
+                    duty_b <= next_b;
+                end
+                default: ;
+            endcase
         end
     end
 
-    // assign the LEDs
+    assign status = {out_mode[3:0], 1'b0, duty_b != '0, duty_g != '0, duty_r != '0};
+
+    // full brightness stays on for the whole period instead of 255 / 256
     always_ff @(posedge clk) begin
-        if(~btn_a) begin
-            led_r <= '0;
-            led_g <= '0;
-            led_b <= '0;
-        end else begin
-            if(falling_scl && data_bits_read == 'd9 && state == 2'b10) begin
-                case (data) 
-                    'h10: begin
-                        led_r <= 0;
-                    end
-                    'h11: begin
-                        led_r <= 1;
-                    end
-                    'h20: begin
-                        led_g <= 0;
-                    end
-                    'h21: begin
-                        led_g <= 1;
-                    end
-                    'h30: begin
-                        led_b <= 0;
-                    end
-                    'h31: begin
-                        led_b <= 1;
-                    end
-                endcase
-            end
-        end
+        led_r <= duty_r == 8'hFF || pwm_cnt < duty_r;
+        led_g <= duty_g == 8'hFF || pwm_cnt < duty_g;
+        led_b <= duty_b == 8'hFF || pwm_cnt < duty_b;
     end
 
     assign state0 = state[0];
     assign state1 = state[1];
 
-    assign dbg0 = address[0];
-    assign dbg1 = address[1];
-    assign dbg2 = address[2];
-    assign dbg3 = address[3];
+    assign dbg0 = pointer[0];
+    assign dbg1 = pointer[1];
+    assign dbg2 = pointer[2];
+    assign dbg3 = out_mode[0];
 
     assign scl_o = 'd0;
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,198 @@
+`timescale 1ns / 1ps
+
+// Self-checking test bench for audio_out: samples streamed over SPI come out in order, the EN high time in
+// every DIR period matches its sample to within the one clock the sigma-delta allows, a starved FIFO counts
+// an underrun and holds EN low, and DRQ drops while the FIFO is over half full. The FIFO is shrunk to 16
+// samples so a full one is quick to reach, the clock is the 25MHz oscillator.
+//
+//   cd verilog/i2c_led
+//   iverilog -g2012 -o audio_out_tb tb/audio_out_tb.sv src/audio_out.sv && vvp audio_out_tb
+module audio_out_tb;
+    localparam int CLK_HZ = 25_000_000;
+    localparam int SAMPLE_HZ = 40_000;
+    localparam int FIFO_BITS = 4;
+    localparam int SAMPLE_DIV = CLK_HZ / SAMPLE_HZ; // 625 clocks per DIR period
+    localparam int SCK_HALF = 200; // 2.5MHz SCK, five clocks per half so the synchronizers see every edge
+
+    logic clk, rst_n;
+    logic sck, mosi, cs_n;
+    logic drq, dir, en;
+    logic [7:0] underruns, level;
+    int errors;
+
+    audio_out #(
+        .CLK_HZ(CLK_HZ),
+        .SAMPLE_HZ(SAMPLE_HZ),
+        .FIFO_BITS(FIFO_BITS)
+    ) dut (
+        .clk(clk),
+        .rst_n(rst_n),
+        .sck_i(sck),
+        .mosi_i(mosi),
+        .cs_n_i(cs_n),
+        .drq(drq),
+        .dir(dir),
+        .en(en),
+        .underruns(underruns),
+        .level(level)
+    );
+
+    initial clk = 1'b0;
+    always #20 clk = ~clk;
+
+    task automatic check(input string what, input int got, input int exp);
+        if(got != exp) begin
+            $error("%s: got %0d expected %0d", what, got, exp);
+            errors++;
+        end
+    endtask
+
+    // one signed sample, low byte first, each byte msb first, with CS already low
+    task automatic spi_word(input logic [15:0] s);
+        logic [15:0] bits;
+        bits = {s[7:0], s[15:8]};
+        for(int i = 15; i >= 0; i--) begin
+            mosi = bits[i];
+            #(SCK_HALF) sck = 1'b1;
+            #(SCK_HALF) sck = 1'b0;
+        end
+    endtask
+
+    // the samples the MCU sent, in offset binary like audio_out plays them, and the ones the monitor saw
+    logic [15:0] sent[$];
+    logic [15:0] played[$];
+
+    // the first eight go out as one burst and the last sixteen as another
+    logic [15:0] samples[24] = '{
+        16'h7FFF, 16'h0000, 16'h8001, 16'h3039, 16'hB1E0, 16'h0064, 16'h4000, 16'hFFFF,
+        16'h1000, 16'hF000, 16'h2000, 16'hE000, 16'h3000, 16'hD000, 16'h0001, 16'h7000,
+        16'h9000, 16'h5555, 16'hAAAA, 16'h0F0F, 16'h8100, 16'h7F00, 16'hC000, 16'h00FF
+    };
+
+    task automatic spi_burst(input int first, input int n);
+        cs_n = 1'b0;
+        #(SCK_HALF);
+        for(int i = first; i < first + n; i++) begin
+            spi_word(samples[i]);
+            sent.push_back({~samples[i][15], samples[i][14:0]});
+        end
+        #(SCK_HALF) cs_n = 1'b1;
+    endtask
+
+    // EN high clocks in each DIR period, checked against the sample that period played. the sigma-delta
+    // carries what is left below one clock into the next pulse, so each period is within one clock of the
+    // exact width and the running total never drifts by more than one
+    logic dir_q;
+    bit in_period;
+    int high;
+    logic [15:0] period_sample;
+    real exact_total;
+    int high_total;
+    int silent_periods;
+    bit en_during_silence;
+
+    task automatic check_period(input logic [15:0] u, input int clocks);
+        real exact;
+        exact = u * real'(SAMPLE_DIV) / 65536.0;
+        if(u == 0) begin
+            ++silent_periods;
+            if(clocks != 0) begin
+                en_during_silence = 1'b1;
+            end
+            return;
+        end
+        played.push_back(u);
+        exact_total += exact;
+        high_total += clocks;
+        if(clocks < $floor(exact) || clocks > $floor(exact) + 1) begin
+            $error("sample %h: EN high %0d clocks, exact width %f", u, clocks, exact);
+            errors++;
+        end
+        if(high_total - exact_total > 1.0 || exact_total - high_total > 1.0) begin
+            $error("EN high time drifted to %0d clocks against %f", high_total, exact_total);
+            errors++;
+        end
+    endtask
+
+    always @(posedge clk) begin
+        dir_q <= dir;
+        if(rst_n && dir && !dir_q) begin
+            if(in_period) begin
+                check_period(period_sample, high);
+            end
+            in_period = 1'b1;
+            period_sample = dut.sample;
+            high = en;
+        end else begin
+            high += en;
+        end
+    end
+
+    bit drq_dropped;
+    always @(posedge clk) begin
+        if(rst_n && !drq) begin
+            drq_dropped = 1'b1;
+        end
+    end
+
+    initial begin
+        errors = 0;
+        in_period = 1'b0;
+        exact_total = 0.0;
+        high_total = 0;
+        silent_periods = 0;
+        en_during_silence = 1'b0;
+        drq_dropped = 1'b0;
+        rst_n = 1'b0;
+        sck = 1'b0;
+        mosi = 1'b0;
+        cs_n = 1'b1;
+        #1000 rst_n = 1'b1;
+
+        // nothing sent yet, the carrier stays off and that does not count as an underrun
+        #100000;
+        check("underruns before playing", underruns, 0);
+        check("EN while idle", en_during_silence, 0);
+        silent_periods = 0;
+
+        // the words arrive faster than they play, so the FIFO never runs dry inside the burst
+        spi_burst(0, 8);
+        check("DRQ with half a FIFO", drq, 1);
+        // at most eight periods play out what is left, the ones after that are starved
+        #(9 * SAMPLE_DIV * 40);
+        silent_periods = 0;
+        #(3 * SAMPLE_DIV * 40);
+        check("underruns after the first burst", underruns, 1);
+        if(silent_periods < 2) begin
+            $error("%0d silent periods while starved", silent_periods);
+            errors++;
+        end
+        check("EN while starved", en_during_silence, 0);
+
+        // sixteen words take about four sample periods to send, so at least eleven are waiting at the end,
+        // past half the 16 word FIFO. DRQ has to drop and come back as it drains
+        spi_burst(8, 16);
+        if(level < 2) begin
+            $error("FIFO level %0d after the second burst", level);
+            errors++;
+        end
+        #(20 * SAMPLE_DIV * 40);
+        check("DRQ dropped while over half full", drq_dropped, 1);
+        check("DRQ back once drained", drq, 1);
+        check("underruns after the second burst", underruns, 2);
+        check("EN while starved again", en_during_silence, 0);
+
+        check("samples played", played.size(), sent.size());
+        for(int i = 0; i < sent.size() && i < played.size(); i++) begin
+            check($sformatf("sample %0d", i), played[i], sent[i]);
+        end
+
+        if(errors == 0) begin
+            $display("audio_out_tb PASS");
+        end else begin
+            $fatal(1, "audio_out_tb %0d errors", errors);
+        end
+        $finish;
+    end
+
+endmodule
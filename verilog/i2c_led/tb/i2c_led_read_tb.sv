@@ -0,0 +1,145 @@
+`timescale 1ns / 1ps
+
+// Self-checking test bench for the i2c_led read path at Fast-mode Plus: register reads after a repeated START,
+// the pointer running across STATUS, ID and the audio counters, the master's ACK and NACK, and the slave
+// settling SDA inside tVD;DAT. Runs the whole top level on the 25MHz oscillator model, 25 clocks per SCL period.
+//
+//   cd verilog/i2c_led
+//   iverilog -g2012 -I tb -o i2c_led_read_tb tb/oscz_model.sv tb/i2c_led_read_tb.sv src/gowin_osc/gowin_osc.v \
+//       src/audio_out.sv src/i2c_led.sv && vvp i2c_led_read_tb
+module i2c_led_read_tb;
+    // 1MHz SCL. hi2c1 is 0x20420B15 on the 120MHz PCLK1, 550ns SCLL and 300ns SCLH that the synchronizers and
+    // rise times stretch to about 1us, and 50ns SDADEL, the shortest hold the slave has to tell apart from a START
+    localparam int T_LOW = 600;
+    localparam int T_HIGH = 400;
+    localparam int T_HD_DAT = 50;
+    // Fast-mode Plus minimums
+    localparam int T_SU_STA = 260;
+    localparam int T_HD_STA = 260;
+    localparam int T_SU_STO = 260;
+    localparam int T_BUF = 500;
+    localparam int T_VD_DAT = 450;
+
+    localparam logic [6:0] DUT_ADDRESS = 7'd69;
+
+    logic btn_a;
+    logic m_scl_low, m_sda_low;
+    logic dut_sda_o, dut_scl_o;
+    wire scl = ~m_scl_low;
+    wire sda = ~(m_sda_low | dut_sda_o);
+    int errors;
+
+    i2c_led dut (
+        .btn_a(btn_a),
+        .sda_i(sda),
+        .scl_i(scl),
+        .sda_o(dut_sda_o),
+        .scl_o(dut_scl_o),
+        .led_r(),
+        .led_g(),
+        .led_b(),
+        .aud_sck(1'b0),
+        .aud_mosi(1'b0),
+        .aud_cs_n(1'b1),
+        .aud_drq(),
+        .aud_dir(),
+        .aud_en(),
+        .state0(),
+        .state1(),
+        .dbg0(),
+        .dbg1(),
+        .dbg2(),
+        .dbg3()
+    );
+
+    `include "i2c_master.svh"
+
+    // pointer write, repeated START, then the read address
+    task automatic start_read(input logic [7:0] pointer);
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(pointer);
+        i2c_start();
+        address(DUT_ADDRESS, 1'b1, 1'b1);
+    endtask
+
+    task automatic expect_byte(input string what, input logic ack, input logic [7:0] exp);
+        logic [7:0] data;
+        read_byte(ack, data);
+        check(what, data, exp);
+    endtask
+
+    initial begin
+        errors = 0;
+        btn_a = 1'b0;
+        m_scl_low = 1'b0;
+        m_sda_low = 1'b0;
+        #1000 btn_a = 1'b1;
+        #1000;
+
+        // red and blue lit, green off, blink mode, latched
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h00);
+        write_data(8'h80);
+        write_data(8'h00);
+        write_data(8'h40);
+        write_data(8'h02);
+        write_data(8'h01);
+        i2c_stop();
+        // the duties follow the latch at the end of the next 256 clock PWM period
+        #30000;
+
+        // what request_status() does, STATUS and ID in one read, here carried on into the audio counters
+        start_read(8'h07);
+        expect_byte("STATUS", 1'b1, 8'h25);
+        expect_byte("ID", 1'b1, 8'h4C);
+        expect_byte("AUDIO_UNDERRUNS", 1'b1, 8'h00);
+        expect_byte("AUDIO_LEVEL", 1'b0, 8'h00);
+        // the NACK ends the read before the STOP, nothing is driven on the next clocks
+        check("idle after NACK", dut.state, 8'h00);
+        check("SDA released after NACK", dut.sda_o, 8'h00);
+        i2c_stop();
+
+        // the colour registers read back as written
+        start_read(8'h00);
+        expect_byte("R", 1'b1, 8'h80);
+        expect_byte("G", 1'b1, 8'h00);
+        expect_byte("B", 1'b1, 8'h40);
+        expect_byte("MODE", 1'b1, 8'h02);
+        expect_byte("LATCH", 1'b0, 8'hFF);
+        i2c_stop();
+
+        // past the end of the map every byte is 0xFF and the pointer stays put
+        start_read(8'h0A);
+        expect_byte("AUDIO_LEVEL", 1'b1, 8'h00);
+        expect_byte("past the map", 1'b1, 8'hFF);
+        expect_byte("past the map again", 1'b0, 8'hFF);
+        i2c_stop();
+        check("pointer held at the end", dut.pointer, 8'd11);
+
+        // a read of another address is NACKed and leaves the bus alone
+        i2c_start();
+        address(7'h50, 1'b1, 1'b0);
+        check("SDA released after a foreign address", dut.sda_o, 8'h00);
+        i2c_stop();
+
+        // a read with no pointer write carries on from where the last one stopped
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h08);
+        i2c_stop();
+        i2c_start();
+        address(DUT_ADDRESS, 1'b1, 1'b1);
+        expect_byte("ID without a pointer write", 1'b0, 8'h4C);
+        i2c_stop();
+
+        if(errors == 0) begin
+            $display("i2c_led_read_tb PASS");
+        end else begin
+            $fatal(1, "i2c_led_read_tb %0d errors", errors);
+        end
+        $finish;
+    end
+
+endmodule
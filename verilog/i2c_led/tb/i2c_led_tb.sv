@@ -0,0 +1,132 @@
+`timescale 1ns / 1ps
+
+// Self-checking test bench for the i2c_led register writes: auto-incrementing bursts, the latch, repeated
+// STARTs, the end of the map and other addresses. Runs the whole top level on the 25MHz oscillator model.
+//
+//   cd verilog/i2c_led
+//   iverilog -g2012 -I tb -o i2c_led_tb tb/oscz_model.sv tb/i2c_led_tb.sv src/gowin_osc/gowin_osc.v \
+//       src/audio_out.sv src/i2c_led.sv && vvp i2c_led_tb
+module i2c_led_tb;
+    // the hi2c1 timing the burst registers were written against, 0x30A175AB on the 120MHz PCLK1, about 100kHz
+    localparam int T_LOW = 5733;
+    localparam int T_HIGH = 3933;
+    localparam int T_HD_DAT = 33;
+    localparam int T_SU_STA = 4700;
+    localparam int T_HD_STA = 4000;
+    localparam int T_SU_STO = 4000;
+    localparam int T_BUF = 4700;
+    localparam int T_VD_DAT = 3450;
+
+    localparam logic [6:0] DUT_ADDRESS = 7'd69;
+
+    logic btn_a;
+    logic m_scl_low, m_sda_low;
+    logic dut_sda_o, dut_scl_o;
+    wire scl = ~m_scl_low;
+    wire sda = ~(m_sda_low | dut_sda_o);
+    int errors;
+
+    i2c_led dut (
+        .btn_a(btn_a),
+        .sda_i(sda),
+        .scl_i(scl),
+        .sda_o(dut_sda_o),
+        .scl_o(dut_scl_o),
+        .led_r(),
+        .led_g(),
+        .led_b(),
+        .aud_sck(1'b0),
+        .aud_mosi(1'b0),
+        .aud_cs_n(1'b1),
+        .aud_drq(),
+        .aud_dir(),
+        .aud_en(),
+        .state0(),
+        .state1(),
+        .dbg0(),
+        .dbg1(),
+        .dbg2(),
+        .dbg3()
+    );
+
+    `include "i2c_master.svh"
+
+    initial begin
+        errors = 0;
+        btn_a = 1'b0;
+        m_scl_low = 1'b0;
+        m_sda_low = 1'b0;
+        #1000 btn_a = 1'b1;
+        #1000;
+
+        // the burst set_leds() sends: pointer R, then R, G, B, MODE and the latch
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h00);
+        write_data(8'h12);
+        write_data(8'h34);
+        write_data(8'h56);
+        write_data(8'h02);
+        // the shadow registers are written but nothing reaches the outputs before the latch byte
+        check("R before latch", dut.reg_r, 8'h12);
+        check("G before latch", dut.reg_g, 8'h34);
+        check("B before latch", dut.reg_b, 8'h56);
+        check("MODE before latch", dut.reg_mode, 8'h02);
+        check("out R before latch", dut.out_r, 8'h00);
+        check("pointer after four bytes", dut.pointer, 8'h04);
+        write_data(8'h01);
+        check("out R", dut.out_r, 8'h12);
+        check("out G", dut.out_g, 8'h34);
+        check("out B", dut.out_b, 8'h56);
+        check("out MODE", dut.out_mode, 8'h02);
+
+        // repeated START straight into a second burst, PERIOD and LEVEL apply without a latch
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h05);
+        write_data(8'h07);
+        write_data(8'h80);
+        i2c_stop();
+        check("PERIOD", dut.period, 8'h07);
+        check("LEVEL", dut.level, 8'h80);
+        check("idle after STOP", dut.state, 8'h00);
+
+        // a burst running off the end of the map stops the pointer instead of wrapping into R
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h06);
+        for(int i = 0; i < 8; i++) begin
+            write_data(8'hA0 + i);
+        end
+        i2c_stop();
+        check("LEVEL from the long burst", dut.level, 8'hA0);
+        check("pointer held at the end", dut.pointer, 8'd11);
+        check("R untouched by the long burst", dut.reg_r, 8'h12);
+
+        // another address is NACKed, and a repeated START to ours still works after it
+        i2c_start();
+        address(7'h50, 1'b0, 1'b0);
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h00);
+        write_data(8'h99);
+        i2c_stop();
+        check("R after the NACKed address", dut.reg_r, 8'h99);
+        check("out R waits for the latch", dut.out_r, 8'h12);
+
+        // a legacy opcode as the first byte still drives its LED on its own
+        i2c_start();
+        address(DUT_ADDRESS, 1'b0, 1'b1);
+        write_data(8'h21);
+        i2c_stop();
+        check("legacy G on", dut.out_g, 8'hFF);
+
+        if(errors == 0) begin
+            $display("i2c_led_tb PASS");
+        end else begin
+            $fatal(1, "i2c_led_tb %0d errors", errors);
+        end
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,17 @@
+`timescale 1ns / 1ps
+
+// Behavioural stand-in for the Gowin OSCZ primitive so the top level simulates with the real oscillator
+// ratio. OSCOUT is 250MHz / FREQ_DIV, 25MHz for the divider in gowin_osc.v
+module OSCZ #(
+    parameter FREQ_DIV = 10,
+    parameter S_RATE = "SLOW"
+)(
+    output logic OSCOUT,
+    input OSCEN
+);
+    localparam real HALF_NS = 2.0 * FREQ_DIV;
+
+    initial OSCOUT = 1'b0;
+    always #(HALF_NS) OSCOUT = OSCEN ? ~OSCOUT : 1'b0;
+
+endmodule